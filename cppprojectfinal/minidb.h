@@ -0,0 +1,87 @@
+//MiniDB的嵌入接口: 把minidb.cpp以-DMINIDB_LIBRARY编译(不含main)后链接, 在程序内直接执行SQL、取类型化的结果
+//引擎内部的错误(原本写到cerr的信息)以minidb::Error抛出
+#ifndef MINIDB_H
+#define MINIDB_H
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace minidb {
+
+class Error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+enum class Type { Integer, Float, Text };
+
+//查询结果的游标: 从第一行之前开始, 每次next()前进一行; 取值按列序号(从0开始)
+class Cursor {
+public:
+    bool next();
+    size_t columnCount() const;
+    const std::string& columnName(size_t col) const;
+    Type columnType(size_t col) const;
+
+    int64_t getInteger(size_t col) const;   // 只用于INTEGER列
+    double getFloat(size_t col) const;      // INTEGER、FLOAT或DECIMAL列(DECIMAL列的类型为Float)
+    std::string getText(size_t col) const;  // 任意列; TEXT值去掉两侧的单引号, DECIMAL值为精确的十进制写法
+
+    struct Result;
+
+private:
+    friend class PreparedStatement;
+    explicit Cursor(std::shared_ptr<Result> result);
+
+    std::shared_ptr<Result> result;
+    size_t position = 0;  // 当前行号加1, 0表示还没调用过next()
+};
+
+//预编译的语句: 解析一次, 可以反复绑定参数执行; 参数用?占位, 只能出现在值的位置(WHERE条件的值、INSERT的值、SET的值)
+class PreparedStatement {
+public:
+    size_t parameterCount() const;
+
+    // 参数序号从1开始; TEXT值不能包含单引号, 可以包含括号和逗号
+    PreparedStatement& bind(size_t index, int64_t value);
+    PreparedStatement& bind(size_t index, double value);
+    PreparedStatement& bind(size_t index, const std::string& value);
+    void clearBindings();
+
+    void execute();  // 执行非查询语句; SELECT的结果丢弃
+    Cursor query();  // 执行SELECT(含INNER JOIN), 返回结果游标
+
+    struct Plan;
+
+private:
+    friend class Connection;
+    explicit PreparedStatement(std::shared_ptr<Plan> plan);
+
+    std::shared_ptr<Plan> plan;
+    std::vector<std::string> values;  // 已绑定参数的SQL字面量, 未绑定为空
+};
+
+//一个数据库会话, 相当于一次minidb进程; 同一个连接同一时刻只能在一个线程中使用
+class Connection {
+public:
+    Connection();
+    ~Connection();
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    void execute(const std::string& sql);
+    Cursor query(const std::string& sql);
+    PreparedStatement prepare(const std::string& sql);
+
+    struct Session;
+
+private:
+    std::shared_ptr<Session> session;
+};
+
+}  // namespace minidb
+
+#endif
@@ -7,6 +7,32 @@
 #include <iterator>
 #include <unordered_map>
 #include <algorithm>
+#include <list>
+#include <memory>
+#include <unordered_set>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string_view>
+#include <limits>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <charconv>
+#include <memory_resource>
+#include <optional>
+#include "minidb.h"
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define MINIDB_X86_SIMD 1
+#endif
 using namespace std;
 
 struct Column {  //将列名和类型分开
@@ -14,743 +40,5871 @@ struct Column {  //将列名和类型分开
     string type;
 };
 
-class Database {
-public:
-    string name;
-    unordered_map<string, vector<vector<string>>> tables;  // 存储表的数据
-    unordered_map<string, vector<Column>> tableColumns;  // 存储表的列信息
+//表的列元数据: 列名->序号的哈希映射和类型向量, 语句执行前一次性解析列名
+struct TableSchema {
+    vector<Column> columns;
+    vector<string> types;
+    unordered_map<string, size_t> ordinals;
 
-    Database() = default;
-    Database(const string& dbName) : name(dbName) {}
+    static const size_t npos = static_cast<size_t>(-1);
+
+    TableSchema() = default;
+    explicit TableSchema(const vector<Column>& cols) : columns(cols) {
+        for(size_t i = 0; i < cols.size(); ++i) {
+            types.push_back(cols[i].type);
+            ordinals.emplace(cols[i].name, i);  // 重名时保留第一个
+        }
+    }
+
+    size_t size() const { return columns.size(); }
+
+    // 列名对应的序号, 不存在时返回npos
+    size_t indexOf(const string& name) const {
+        auto it = ordinals.find(name);
+        return it == ordinals.end() ? npos : it->second;
+    }
+
+    vector<string> names() const {
+        vector<string> result;
+        for(const auto& col : columns) result.push_back(col.name);
+        return result;
+    }
 };
 
-class MiniDB {
-public:
+enum class CmpOp { EQ, NE, LT, GT, OTHER };
 
-    unordered_map<string, Database> databases;
-    Database* currentDatabase = nullptr;
-    bool isprint=false;
+inline CmpOp parseCmpOp(const string& op) {
+    if(op == "=") return CmpOp::EQ;
+    if(op == "!=") return CmpOp::NE;
+    if(op == "<") return CmpOp::LT;
+    if(op == ">") return CmpOp::GT;
+    return CmpOp::OTHER;
+}
 
-void create_database(const string& dbName)
-{
-    if (databases.find(dbName) != databases.end()) {
-        cerr << "Database " << dbName << " already exists" << endl;
-        return;
+//已解析的单个WHERE条件
+struct Condition {
+    size_t index = TableSchema::npos;  // 列序号
+    string op;
+    string value;
+    string type;
+    CmpOp cmp = CmpOp::OTHER;
+    int64_t intValue = 0;  // INTEGER列的比较值, 解析一次
+    float floatValue = 0;  // FLOAT列的比较值, 解析一次
+};
+
+//已解析的WHERE条件组: 一个条件, 或两个条件由AND/OR连接
+struct ConditionSet {
+    vector<Condition> conds;
+    string logicalOp;
+
+    bool empty() const { return conds.empty(); }
+};
+
+//向量化过滤内核: 对连续的数值列与常量比较, 结果写入选择位图(每行1位)
+//运行时按CPU选择AVX2 / SSE4.2 / 标量实现, 位图调用前需清零
+//标量实现, 处理[start, n), 也用于向量实现的尾部
+template<typename T>
+void filterScalar(const T* data, size_t start, size_t n, CmpOp op, T c, uint64_t* bits) {
+    for(size_t i = start; i < n; ++i) {
+        bool hit = op == CmpOp::EQ ? data[i] == c : op == CmpOp::NE ? data[i] != c :
+                   op == CmpOp::LT ? data[i] < c : data[i] > c;
+        bits[i / 64] |= static_cast<uint64_t>(hit) << (i % 64);
     }
-    databases[dbName] = Database(dbName);
-    save_database(databases[dbName]);
 }
 
-void use_database(const string dbName)
-{
-    string dbFileName = dbName + ".db";
-    ifstream file(dbFileName);
-    if (!file.is_open()) {
-        cerr << "Database " << dbName << " does not exist" << endl;
-        return;
+#ifdef MINIDB_X86_SIMD
+__attribute__((target("avx2")))
+void filterInt64AVX2(const int64_t* data, size_t n, CmpOp op, int64_t c, uint64_t* bits) {
+    __m256i k = _mm256_set1_epi64x(c);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i m = op == CmpOp::GT ? _mm256_cmpgt_epi64(v, k) :
+                    op == CmpOp::LT ? _mm256_cmpgt_epi64(k, v) : _mm256_cmpeq_epi64(v, k);
+        uint64_t mask = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+        if(op == CmpOp::NE) mask ^= 0xF;
+        bits[i / 64] |= mask << (i % 64);
     }
-    file.close();
+    filterScalar(data, i, n, op, c, bits);
+}
 
-    load_database(dbFileName);
+__attribute__((target("avx2")))
+void filterFloatAVX2(const float* data, size_t n, CmpOp op, float c, uint64_t* bits) {
+    __m256 k = _mm256_set1_ps(c);
+    size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(data + i);
+        __m256 m = op == CmpOp::EQ ? _mm256_cmp_ps(v, k, _CMP_EQ_OQ) :
+                   op == CmpOp::NE ? _mm256_cmp_ps(v, k, _CMP_NEQ_UQ) :
+                   op == CmpOp::LT ? _mm256_cmp_ps(v, k, _CMP_LT_OQ) : _mm256_cmp_ps(v, k, _CMP_GT_OQ);
+        bits[i / 64] |= static_cast<uint64_t>(static_cast<unsigned>(_mm256_movemask_ps(m))) << (i % 64);
+    }
+    filterScalar(data, i, n, op, c, bits);
 }
 
-void create_table(const string& tableName, const vector<string>& columns) {
-    if(!currentDatabase) {
-        cerr << "No database selected" << endl;
-        return;
+__attribute__((target("sse4.2")))
+void filterInt64SSE42(const int64_t* data, size_t n, CmpOp op, int64_t c, uint64_t* bits) {
+    __m128i k = _mm_set1_epi64x(c);
+    size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i m = op == CmpOp::GT ? _mm_cmpgt_epi64(v, k) :
+                    op == CmpOp::LT ? _mm_cmpgt_epi64(k, v) : _mm_cmpeq_epi64(v, k);
+        uint64_t mask = static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+        if(op == CmpOp::NE) mask ^= 0x3;
+        bits[i / 64] |= mask << (i % 64);
     }
-    
-    if (currentDatabase->tables.find(tableName) != currentDatabase->tables.end()) {
-        cerr << "Table " << tableName << " already exists" << endl;
-        return;
+    filterScalar(data, i, n, op, c, bits);
+}
+
+__attribute__((target("sse4.2")))
+void filterFloatSSE42(const float* data, size_t n, CmpOp op, float c, uint64_t* bits) {
+    __m128 k = _mm_set1_ps(c);
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(data + i);
+        __m128 m = op == CmpOp::EQ ? _mm_cmpeq_ps(v, k) : op == CmpOp::NE ? _mm_cmpneq_ps(v, k) :
+                   op == CmpOp::LT ? _mm_cmplt_ps(v, k) : _mm_cmpgt_ps(v, k);
+        bits[i / 64] |= static_cast<uint64_t>(static_cast<unsigned>(_mm_movemask_ps(m))) << (i % 64);
     }
-    
-    vector<Column> tableColumns;
-    vector<string> columnNames;
-    
-    for(const auto& col : columns) {
-        istringstream iss(col);
-        string name, type;
-        iss >> name >> type;
-        tableColumns.push_back({name, type});
-        columnNames.push_back(name);
+    filterScalar(data, i, n, op, c, bits);
+}
+#endif
+
+enum class SimdLevel { SCALAR, SSE42, AVX2 };
+
+inline SimdLevel simdLevel() {
+#ifdef MINIDB_X86_SIMD
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+        if(__builtin_cpu_supports("sse4.2")) return SimdLevel::SSE42;
+        return SimdLevel::SCALAR;
+    }();
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+inline const char* simdLevelName(SimdLevel level) {
+    return level == SimdLevel::AVX2 ? "avx2" : level == SimdLevel::SSE42 ? "sse4.2" : "scalar";
+}
+
+// op只能是EQ/NE/LT/GT
+inline void filterInt64(const int64_t* data, size_t n, CmpOp op, int64_t c, uint64_t* bits) {
+#ifdef MINIDB_X86_SIMD
+    switch(simdLevel()) {
+        case SimdLevel::AVX2: filterInt64AVX2(data, n, op, c, bits); return;
+        case SimdLevel::SSE42: filterInt64SSE42(data, n, op, c, bits); return;
+        default: break;
     }
-    
-    currentDatabase->tables[tableName] = {columnNames};  // 只存储列名
-    currentDatabase->tableColumns[tableName] = tableColumns;  // 存储列名和类型
-    save_database(*currentDatabase);
+#endif
+    filterScalar(data, 0, n, op, c, bits);
 }
 
-void drop_table(const string& tableName)
-{
-    if(currentDatabase)
-    {
-        if (currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
-            cerr << "Table " << tableName << " does not exist" << endl;
-            return;
-        }
-        currentDatabase->tables.erase(tableName);
-        save_database(*currentDatabase);
+inline void filterFloat(const float* data, size_t n, CmpOp op, float c, uint64_t* bits) {
+#ifdef MINIDB_X86_SIMD
+    switch(simdLevel()) {
+        case SimdLevel::AVX2: filterFloatAVX2(data, n, op, c, bits); return;
+        case SimdLevel::SSE42: filterFloatSSE42(data, n, op, c, bits); return;
+        default: break;
     }
-    else
-    {
-        cerr<<"No database selected"<<endl;
-    
+#endif
+    filterScalar(data, 0, n, op, c, bits);
+}
+
+const size_t BLOCK_ROWS = 1024;  // 内存表按块扫描时每块的行数, 也是内存表块统计的粒度
+const size_t PARTITION_PREFETCH = 4;  // 并行读分区时每个分区最多预读的块数
+const size_t DEFAULT_PARTITIONS = 4;  // PARTITION BY HASH不写PARTITIONS时的分区数
+const size_t MAX_PARTITIONS = 256;
+
+//FLOAT值按原来的规则解析: 去掉可能的单引号后按float读取
+inline float parseFloat(string_view value) {
+    string val(value);
+    if (!val.empty() && val.front() == '\'') val = val.substr(1, val.length() - 2);
+    return stof(val);
+}
+
+//列类型的存储类别: 'I' INTEGER, 'F' FLOAT, 'D' DECIMAL(p,s), 'T' TEXT
+inline char columnKind(const string& type) {
+    return type == "INTEGER" ? 'I' : type == "FLOAT" ? 'F' : type.rfind("DECIMAL(", 0) == 0 ? 'D' : 'T';
+}
+
+//按内联64位整数存储和比较的类型: INTEGER, 以及按10^s缩放的DECIMAL(p,s)
+inline bool integralType(const string& type) {
+    char kind = columnKind(type);
+    return kind == 'I' || kind == 'D';
+}
+
+//DECIMAL(p,s): 值乘以10^s存为64位整数, 比较和运算都在整数上进行, 输出时按s位小数精确格式化
+//p最多18位, 缩放后的值总能放进int64
+const int MAX_DECIMAL_PRECISION = 18;
+
+inline int64_t pow10i(int n) {
+    int64_t v = 1;
+    while(n-- > 0) v *= 10;
+    return v;
+}
+
+//规范的类型写法DECIMAL(p,s)中的p和s; 不是DECIMAL时返回false, p和s不变
+inline bool decimalType(const string& type, int& precision, int& scale) {
+    if(columnKind(type) != 'D') return false;
+    size_t comma = type.find(',');
+    precision = atoi(type.c_str() + 8);
+    scale = comma == string::npos ? 0 : atoi(type.c_str() + comma + 1);
+    return true;
+}
+
+inline int decimalScale(const string& type) {
+    int precision = 0, scale = 0;
+    decimalType(type, precision, scale);
+    return scale;
+}
+
+//建表时的类型写法: DECIMAL、DECIMAL(p)、DECIMAL(p,s)(可带空格)规范为DECIMAL(p,s), p缺省为18, s缺省为0;
+//p不在1到18之间或s不在0到p之间时返回空串; 其它类型原样返回
+inline string normalizeType(const string& type) {
+    if(type.rfind("DECIMAL", 0) != 0) return type;
+    string args;
+    for(char c : type.substr(7)) {
+        if(!isspace(static_cast<unsigned char>(c))) args += c;
+    }
+    int precision = MAX_DECIMAL_PRECISION, scale = 0;
+    if(!args.empty()) {
+        size_t comma = args.find(',');
+        if(args.front() != '(' || args.back() != ')') return "";
+        string p = args.substr(1, (comma == string::npos ? args.size() - 1 : comma) - 1);
+        string s = comma == string::npos ? "0" : args.substr(comma + 1, args.size() - comma - 2);
+        if(p.empty() || s.empty() || !all_of(p.begin(), p.end(), ::isdigit) || !all_of(s.begin(), s.end(), ::isdigit) || p.size() > 2 || s.size() > 2) return "";
+        precision = stoi(p);
+        scale = stoi(s);
     }
+    if(precision < 1 || precision > MAX_DECIMAL_PRECISION || scale > precision) return "";
+    return "DECIMAL(" + to_string(precision) + "," + to_string(scale) + ")";
 }
 
-void insert_into_table(const string& tableName, const vector<string>& values)
-{
-    if(currentDatabase)
-    {
-        if(currentDatabase->tables.find(tableName)!=currentDatabase->tables.end())
-        {
-            vector<string> cleanValues;
-        for(size_t i = 0; i < values.size(); ++i) {
-            string cleanValue = values[i];
-            // 根据列类型处理数据
-            string colType = currentDatabase->tableColumns[tableName][i].type;
-            
-           // 去除逗号
-            while(!cleanValue.empty() && (cleanValue.back() == ',' || cleanValue.back() == ' ')) {
-                cleanValue.pop_back();
-            }
+//十进制文本按scale位小数缩放后的整数; 多出的小数位四舍五入(远离0)得到rounded, 向负无穷取整得到floor
+struct DecimalValue {
+    int64_t rounded = 0, floor = 0;
+    bool exact = true;  // 多出的小数位全为0
+};
 
-            // 如果是TEXT类型，确保字符串被单引号包裹
-            if(colType == "TEXT") {
-                if(cleanValue.front() != '\'' || cleanValue.back() != '\'') {
-                    cerr << "Invalid TEXT value format: " << cleanValue << endl;
-                    return;
-                }
-            }
-            
-            cleanValues.push_back(cleanValue);
-        }
-            currentDatabase->tables[tableName].push_back(cleanValues);
-            save_database(*currentDatabase);
+//可带单引号和正负号; 不是十进制数或有效数字超过18位时返回false
+inline bool parseDecimal(string_view text, int scale, DecimalValue& out) {
+    if(text.size() >= 2 && text.front() == '\'' && text.back() == '\'') text = text.substr(1, text.size() - 2);
+    size_t i = 0;
+    bool negative = false;
+    if(i < text.size() && (text[i] == '+' || text[i] == '-')) negative = text[i++] == '-';
+    int64_t magnitude = 0;
+    int digits = 0, fraction = -1;  // fraction: 已读的小数位数, 还没遇到小数点时为-1
+    bool any = false, roundUp = false;
+    out.exact = true;
+    for(; i < text.size(); ++i) {
+        char c = text[i];
+        if(c == '.' && fraction < 0) {
+            fraction = 0;
+            continue;
         }
-        else
-        {
-            cerr<<"Table "<<tableName<<" does not exist"<<endl;
+        if(!isdigit(static_cast<unsigned char>(c))) return false;
+        any = true;
+        if(fraction >= scale) {
+            if(fraction == scale) roundUp = c >= '5';
+            if(c != '0') out.exact = false;
+            ++fraction;
+            continue;
         }
+        if(fraction >= 0) ++fraction;
+        if(magnitude == 0 && c == '0') continue;
+        if(++digits > MAX_DECIMAL_PRECISION) return false;
+        magnitude = magnitude * 10 + (c - '0');
     }
-    else
-    {
-        cerr<<"No database selected"<<endl;
+    if(!any) return false;
+    for(int f = max(fraction, 0); f < scale; ++f) {
+        if(magnitude != 0 && ++digits > MAX_DECIMAL_PRECISION) return false;
+        magnitude *= 10;
     }
+    out.rounded = negative ? -(magnitude + roundUp) : magnitude + roundUp;
+    out.floor = negative ? -(magnitude + !out.exact) : magnitude;
+    return true;
 }
 
-void select_to_file(const string& tableName, const vector<string>& columnNames, const vector<string>& conditions, const string& outputFile)
-{
-    if (!currentDatabase) {
-        cerr << "No database selected" << endl;
-        return;
+inline bool decimalFits(int64_t v, int precision) {
+    int64_t limit = pow10i(precision);
+    return v > -limit && v < limit;
+}
+
+//按scale位小数格式化缩放后的整数, 写入out(至少24字节), 返回长度
+inline size_t formatDecimal(int64_t v, int scale, char* out) {
+    char digits[24];
+    uint64_t magnitude = v < 0 ? 0 - static_cast<uint64_t>(v) : static_cast<uint64_t>(v);
+    size_t n = to_chars(digits, digits + sizeof(digits), magnitude).ptr - digits;
+    size_t len = 0;
+    if(v < 0) out[len++] = '-';
+    size_t width = max<size_t>(n, scale + 1);  // 整数部分至少一位
+    for(size_t k = 0; k < width; ++k) {
+        if(scale > 0 && k == width - scale) out[len++] = '.';
+        out[len++] = k < width - n ? '0' : digits[k - (width - n)];
     }
+    return len;
+}
 
-    if (currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
-        cerr << "Table " << tableName << " does not exist" << endl;
-        return;
+inline string formatDecimal(int64_t v, int scale) {
+    char buffer[24];
+    return string(buffer, formatDecimal(v, scale, buffer));
+}
+
+//块统计(zone map)中一列的取值范围
+struct ColumnRange {
+    bool seen = false;  // 是否已有值
+    bool usable = true;  // 出现无法解析的值时不能再用于跳过
+    int64_t imin = 0, imax = 0;
+    float fmin = 0, fmax = 0;
+    string smin, smax;
+
+    void include(int64_t v) {
+        imin = seen ? min(imin, v) : v;
+        imax = seen ? max(imax, v) : v;
+        seen = true;
     }
 
-    // 使用追加模式打开文件
-    ofstream file(outputFile, ios::app);
-    if (!file.is_open()) {
-        cerr << "Unable to open file: " << outputFile << endl;
-        return;
+    void include(float v) {
+        fmin = seen ? min(fmin, v) : v;
+        fmax = seen ? max(fmax, v) : v;
+        seen = true;
     }
 
-    if(isprint)
-    {
-        file<<"---"<<endl;
+    void include(string_view v) {
+        if(!seen || v < smin) smin.assign(v);
+        if(!seen || v > smax) smax.assign(v);
+        seen = true;
     }
-    else
-    {
-        isprint=true;
+};
+
+template<typename T>
+bool rangeMayMatch(const T& lo, const T& hi, const T& c, CmpOp op) {
+    switch(op) {
+        case CmpOp::EQ: return !(c < lo) && !(hi < c);
+        case CmpOp::NE: return !(lo == c && hi == c);
+        case CmpOp::LT: return lo < c;
+        case CmpOp::GT: return c < hi;
+        default: return true;
     }
+}
 
-    const auto& table = currentDatabase->tables[tableName];
-    const auto& header = table.front();
+//一个行块的统计: 行数和每列的最小/最大值; 块内不可能有行满足WHERE时整块跳过
+struct Zone {
+    size_t rows = 0;
+    vector<ColumnRange> cols;
 
-    for(const auto& col:columnNames)
-    {
-        file<<col;
-        if(col!=columnNames.back())
-        {
-            file<<",";
+    Zone() = default;
+    explicit Zone(size_t columnCount) : cols(columnCount) {}
+
+    // DECIMAL列按缩放后的整数计入, scale为它的小数位数
+    void includeValue(size_t col, char kind, string_view value, int scale = 0) {
+        ColumnRange& range = cols[col];
+        try {
+            DecimalValue d;
+            if(kind == 'D' && !parseDecimal(value, scale, d)) range.usable = false;
+            else if(kind == 'D') range.include(d.rounded);
+            else if(kind == 'I') range.include(static_cast<int64_t>(stoll(string(value))));
+            else if(kind == 'F') range.include(parseFloat(value));
+            else range.include(value);
+        } catch(...) {
+            range.usable = false;
         }
     }
-    file<<endl;
 
-    vector<size_t> colIndices;
-    if (columnNames.size() == 1 && columnNames[0] == "*") {
-        for (size_t i = 0; i < header.size(); ++i) {
-            colIndices.push_back(i);
-        }
-    } else {
-        for (const auto& colName : columnNames) {
-            auto it = find(header.begin(), header.end(), colName);
-            if (it != header.end()) {
-                colIndices.push_back(distance(header.begin(), it));
-            } else {
-                cerr << "Column " << colName << " does not exist in table " << tableName << endl;
-                return;
+    bool mayMatch(const Condition& cond) const {
+        if(rows == 0) return false;
+        if(cond.index == TableSchema::npos || cond.cmp == CmpOp::OTHER) return true;
+        const ColumnRange& range = cols[cond.index];
+        if(!range.seen || !range.usable) return true;
+        if(integralType(cond.type)) return rangeMayMatch(range.imin, range.imax, cond.intValue, cond.cmp);
+        if(cond.type == "FLOAT") return rangeMayMatch(range.fmin, range.fmax, cond.floatValue, cond.cmp);
+        return rangeMayMatch(string_view(range.smin), string_view(range.smax), string_view(cond.value), cond.cmp);
+    }
+
+    bool mayMatch(const ConditionSet& where) const {
+        if(rows == 0) return false;
+        if(where.empty()) return true;
+        bool first = mayMatch(where.conds[0]);
+        if(where.logicalOp.empty()) return first;
+        bool second = where.conds.size() > 1 && mayMatch(where.conds[1]);
+        if(where.logicalOp == "AND") return first && second;
+        if(where.logicalOp == "OR") return first || second;
+        return true;
+    }
+
+    // 二进制读写, 用于随页文件持久化
+    void write(ostream& out) const {
+        uint32_t n = static_cast<uint32_t>(rows);
+        out.write(reinterpret_cast<const char*>(&n), 4);
+        for(const auto& range : cols) {
+            char flags = static_cast<char>(range.seen | (range.usable << 1));
+            out.write(&flags, 1);
+            out.write(reinterpret_cast<const char*>(&range.imin), 8);
+            out.write(reinterpret_cast<const char*>(&range.imax), 8);
+            out.write(reinterpret_cast<const char*>(&range.fmin), 4);
+            out.write(reinterpret_cast<const char*>(&range.fmax), 4);
+            for(const string* str : {&range.smin, &range.smax}) {
+                uint32_t len = static_cast<uint32_t>(str->size());
+                out.write(reinterpret_cast<const char*>(&len), 4);
+                out.write(str->data(), len);
             }
         }
     }
-        for (size_t i = 1; i < table.size(); ++i) {
-        const auto& row = table[i];
-        if (conditions.empty() || evaluateConditions(row, header, conditions, tableName)) {
-            // 输出满足条件的行
-            for (size_t j = 0; j < colIndices.size(); ++j) {
-                file << row[colIndices[j]];
-                if (j < colIndices.size() - 1) file << ",";
+
+    bool read(istream& in) {
+        uint32_t n;
+        if(!in.read(reinterpret_cast<char*>(&n), 4)) return false;
+        rows = n;
+        for(auto& range : cols) {
+            char flags;
+            in.read(&flags, 1);
+            range.seen = flags & 1;
+            range.usable = (flags >> 1) & 1;
+            in.read(reinterpret_cast<char*>(&range.imin), 8);
+            in.read(reinterpret_cast<char*>(&range.imax), 8);
+            in.read(reinterpret_cast<char*>(&range.fmin), 4);
+            in.read(reinterpret_cast<char*>(&range.fmax), 4);
+            for(string* str : {&range.smin, &range.smax}) {
+                uint32_t len = 0;
+                in.read(reinterpret_cast<char*>(&len), 4);
+                str->resize(len);
+                in.read(&(*str)[0], len);
             }
-            file << endl;
         }
+        return static_cast<bool>(in);
     }
-    file.close();
-}
+};
 
-void inner_join_file(const string& table1, const string& table2, const vector<string>& columnNames, const vector<string>& conditions, const string& outputFile)
-{
-    if(!currentDatabase) {
-        cerr << "No database selected" << endl;
-        return;
-    }
-    
-    if(currentDatabase->tables.find(table1) == currentDatabase->tables.end() || 
-       currentDatabase->tables.find(table2) == currentDatabase->tables.end()) {
-        cerr << "Table does not exist" << endl;
-        return;
+//行存储: 整张表的行连续存放在一块内存中, 每行固定宽度, 按 行号*行宽 寻址
+//INTEGER列直接内联8字节整数; FLOAT/TEXT列内联(偏移,长度), 文本放在表自己的文本区
+//DROP TABLE时整张表只有这两块内存需要释放
+class RowStore {
+public:
+    RowStore() = default;
+    // zoned为true时按BLOCK_ROWS行维护块统计; 扫描用的临时块不需要
+    explicit RowStore(const vector<string>& types, bool zoned = true) : zoned(zoned) {
+        for(const auto& type : types) {
+            int precision = 0, scale = 0;
+            decimalType(type, precision, scale);
+            inlineInt.push_back(integralType(type));
+            kinds.push_back(columnKind(type));
+            decimals.push_back({static_cast<char>(precision), static_cast<char>(scale)});
+        }
     }
 
-    // 使用追加模式
-    ofstream file(outputFile, ios::app);
-    if(!file.is_open()) {
-        cerr << "Unable to open file: " << outputFile << endl;
-        return;
-    }
+    size_t size() const { return rowCount; }
+    size_t columnCount() const { return inlineInt.size(); }
+    size_t rowWidth() const { return inlineInt.size() * SLOT_SIZE; }
+    bool isInteger(size_t col) const { return inlineInt[col]; }
 
-    if(isprint)
-    {
-        file<<"---"<<endl;
+    int64_t integer(size_t row, size_t col) const {
+        int64_t v;
+        memcpy(&v, slot(row, col), sizeof(v));
+        return v;
     }
-    else
-    {
-        isprint=true;
+
+    string_view text(size_t row, size_t col) const {
+        uint32_t off, len;
+        memcpy(&off, slot(row, col), 4);
+        memcpy(&len, slot(row, col) + 4, 4);
+        return string_view(arena.data() + off, len);
     }
 
-    const auto& res_table = currentDatabase->tables[table1];
-    const auto& tag_table = currentDatabase->tables[table2];
-    const auto& res_header = res_table.front();
-    const auto& tag_header = tag_table.front();
-    
-    // 列名
-    vector<pair<string,string>> join_columns;
-    vector<pair<string,string>> join_conditions;
-    vector<string> where_conditions;
-    pair<string,string> table_names;
-    //分离列名
-    vector<string> join= vector<string>(conditions.begin(), conditions.begin() + 2);
-    vector<string> where= vector<string>(conditions.begin() + 2, conditions.end());
- 
-    for(const auto& column : columnNames) {
-        size_t dot_pos = column.find('.');
-        join_columns.push_back(make_pair(
-            column.substr(0, dot_pos),
-            column.substr(dot_pos + 1)
-        ));
+    string get(size_t row, size_t col) const {
+        if(kinds[col] == 'D') return formatDecimal(integer(row, col), decimals[col].scale);
+        return inlineInt[col] ? to_string(integer(row, col)) : string(text(row, col));
     }
 
-    for(const auto& condition : join) {
-        size_t dot_pos = condition.find('.');
-        join_conditions.push_back(make_pair(
-            condition.substr(0, dot_pos),
-            condition.substr(dot_pos + 1)
-        ));
+    template<typename Str>
+    void appendTo(Str& out, size_t row, size_t col) const {
+        if(kinds[col] == 'D') {
+            char buffer[24];
+            out.append(buffer, formatDecimal(integer(row, col), decimals[col].scale, buffer));
+        } else if(inlineInt[col]) {
+            char buffer[24];
+            auto written = to_chars(buffer, buffer + sizeof(buffer), integer(row, col));
+            out.append(buffer, written.ptr);
+        } else {
+            out.append(text(row, col));
+        }
     }
 
+    vector<string> row(size_t r) const {
+        vector<string> values;
+        for(size_t c = 0; c < columnCount(); ++c) {
+            values.push_back(get(r, c));
+        }
+        return values;
+    }
 
-    for(const auto& condition : where) {
-        if(condition.find('.')&&table_names.first.empty())
-        {
-            size_t dot_pos = condition.find('.');
-            table_names.first=condition.substr(0,dot_pos);
-            where_conditions.push_back(condition.substr(dot_pos+1));
+    template<typename Row = vector<string>>
+    void append(const Row& values) {
+        slots.resize(slots.size() + rowWidth());
+        ++rowCount;
+        for(size_t c = 0; c < columnCount(); ++c) {
+            write(rowCount - 1, c, c < values.size() ? string_view(values[c]) : string_view());
         }
-        else if(where.size()>3&&condition==where[3])
-        {
-            size_t dot_pos = condition.find('.');
-            table_names.second=condition.substr(0,dot_pos);
-            where_conditions.push_back(condition.substr(dot_pos+1));
+        if(zoned) {
+            if(zoneList.size() * BLOCK_ROWS < rowCount) zoneList.emplace_back(columnCount());
+            Zone& zone = zoneList.back();
+            zone.rows++;
+            includeRow(zone, rowCount - 1);
         }
-        else
-        {
-            where_conditions.push_back(condition);
+    }
+
+    // 从另一个同结构的行存储复制一行, 不经过文本转换(连接建哈希表时用)
+    void appendFrom(const RowStore& other, size_t r) {
+        slots.resize(slots.size() + rowWidth());
+        ++rowCount;
+        for(size_t c = 0; c < columnCount(); ++c) {
+            if(inlineInt[c]) {
+                memcpy(slot(rowCount - 1, c), other.slot(r, c), SLOT_SIZE);
+            } else {
+                writeText(rowCount - 1, c, other.text(r, c));
+            }
+        }
+        if(zoned) {
+            if(zoneList.size() * BLOCK_ROWS < rowCount) zoneList.emplace_back(columnCount());
+            Zone& zone = zoneList.back();
+            zone.rows++;
+            includeRow(zone, rowCount - 1);
         }
     }
 
-    // 写入列名
-    for(size_t i = 0; i < join_columns.size(); ++i) {
-        file <<join_columns[i].first<<"." <<join_columns[i].second;
-        if(i < join_columns.size() - 1) {
-            file << ",";
+    // 只复制cols中的列, 其余列留为0或空串; 连接时复制行只带上之后还要用到的列, 不维护块统计
+    void appendFrom(const RowStore& other, size_t r, const vector<size_t>& cols) {
+        slots.resize(slots.size() + rowWidth());
+        ++rowCount;
+        for(size_t c : cols) {
+            if(inlineInt[c]) {
+                memcpy(slot(rowCount - 1, c), other.slot(r, c), SLOT_SIZE);
+            } else {
+                writeText(rowCount - 1, c, other.text(r, c));
+            }
         }
     }
-    file << endl;
 
-    // 连接
-    for(size_t i = 1; i < res_table.size(); i++) {
-        for(size_t j = 1; j < tag_table.size(); j++) {
-            bool match = true;
-            
-            // 检查连接条件
-            auto it1 = find(res_header.begin(), res_header.end(), join_conditions[0].second);
-            auto it2 = find(tag_header.begin(), tag_header.end(), join_conditions[1].second);
+    // 追加一行, 第c列取自cells[c]指向的(表, 行, 列), 表为空时留为0或空串; 源列与第c列类型相同
+    // 库接口收集查询结果时用, 不经过文本转换, 不维护块统计
+    struct Cell {
+        const RowStore* table;
+        size_t row, col;
+    };
+    void appendCells(const vector<Cell>& cells) {
+        slots.resize(slots.size() + rowWidth());
+        ++rowCount;
+        for(size_t c = 0; c < columnCount() && c < cells.size(); ++c) {
+            const Cell& cell = cells[c];
+            if(!cell.table) continue;
+            if(inlineInt[c]) {
+                memcpy(slot(rowCount - 1, c), cell.table->slot(cell.row, cell.col), SLOT_SIZE);
+            } else {
+                writeText(rowCount - 1, c, cell.table->text(cell.row, cell.col));
+            }
+        }
+    }
 
-            if(it1 != res_header.end() && it2 != tag_header.end()) {
-                size_t index1 = distance(res_header.begin(), it1);
-                size_t index2 = distance(tag_header.begin(), it2);
-    
-                if(res_table[i][index1] != tag_table[j][index2]) {
-                    match = false;
-                }
+    // 追加一行, 只解码columns中选中的列, 其余列留为0或空串; 扫描页时只取查询用到的列, 不维护块统计
+    void appendColumns(const vector<string_view>& values, const vector<bool>& columns) {
+        slots.resize(slots.size() + rowWidth());
+        ++rowCount;
+        for(size_t c = 0; c < columnCount() && c < values.size(); ++c) {
+            if(!columns[c]) continue;
+            if(inlineInt[c]) {
+                write(rowCount - 1, c, string(values[c]));
+            } else {
+                writeText(rowCount - 1, c, values[c]);
             }
+        }
+    }
 
-            //检查WHERE条件
-            if(!where_conditions.empty())
-            {
-                if(where_conditions.size()>3)
-                {
-                    string and_or=where_conditions[3];
-                    const auto& current_table1=currentDatabase->tables[table_names.first];
-                    const auto& current_table2=currentDatabase->tables[table_names.second];
-                    if(and_or=="AND")
-                    {
-                        match=match&&evaluateSingleCondition(current_table1[i],current_table1[0],where_conditions[0],where_conditions[1],where_conditions[2],table_names.first)&&evaluateSingleCondition(current_table2[j],current_table2[0],where_conditions[4],where_conditions[5],where_conditions[6],table_names.second);
-                    }
-                    else if(and_or=="OR")
-                    {
-                        match=match&&(evaluateSingleCondition(current_table1[i],current_table1[0],where_conditions[0],where_conditions[1],where_conditions[2],table_names.first)||evaluateSingleCondition(current_table2[j],current_table2[0],where_conditions[4],where_conditions[5],where_conditions[6],table_names.second));
-                    }
-                }
-                else
-                {
-                    const auto& current_table=currentDatabase->tables[table_names.first];
-                    match=match&&evaluateSingleCondition(current_table[i],current_table[0],where_conditions[0],where_conditions[1],where_conditions[2],table_names.first);
-                }
+    // 落盘格式: 第r行cols中的列依次追加到out, 整数8字节, 其余4字节长度加内容
+    void encodeTo(string& out, size_t r, const vector<size_t>& cols) const {
+        for(size_t c : cols) {
+            if(inlineInt[c]) {
+                out.append(slot(r, c), SLOT_SIZE);
+                continue;
             }
+            string_view value = text(r, c);
+            uint32_t len = static_cast<uint32_t>(value.size());
+            out.append(reinterpret_cast<const char*>(&len), 4);
+            out.append(value);
+        }
+    }
 
-            // 输出匹配的行
-            if(match) {
-                for(size_t k = 0; k < join_columns.size(); ++k) {
-                    const auto& col = join_columns[k];
-                    if(col.first == table1) {
-                        auto it = find(res_header.begin(), res_header.end(), col.second);
-                        if(it != res_header.end()) {
-                            size_t index = distance(res_header.begin(), it);
-                            file << res_table[i][index];
-                        }
-                    } else {
-                        auto it = find(tag_header.begin(), tag_header.end(), col.second);
-                        if(it != tag_header.end()) {
-                            size_t index = distance(tag_header.begin(), it);
-                            file << tag_table[j][index];
-                        }
-                    }
-                    
-                    if(k < join_columns.size() - 1) {
-                        file << ",";
-                    }
-                }
-                file << endl;
+    // 按encodeTo的格式从in读出cols中的列追加为一行, 其余列留为0或空串, 不维护块统计; 返回读完后的位置
+    const char* appendEncoded(const char* in, const vector<size_t>& cols) {
+        slots.resize(slots.size() + rowWidth());
+        ++rowCount;
+        for(size_t c : cols) {
+            if(inlineInt[c]) {
+                memcpy(slot(rowCount - 1, c), in, SLOT_SIZE);
+                in += SLOT_SIZE;
+                continue;
             }
+            uint32_t len;
+            memcpy(&len, in, 4);
+            writeText(rowCount - 1, c, string_view(in + 4, len));
+            in += 4 + len;
         }
+        return in;
     }
-    
-    file.close();
-}
 
-void update_table(const string& tableName, const vector<pair<string, string>>& updates, vector<string>& conditions) {
-    if(!currentDatabase || currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
-        return;
+    // 占用的内存: 行区、文本区和块统计, 按已分配的容量计
+    size_t memoryBytes() const {
+        size_t bytes = slots.capacity() + arena.capacity() + zoneList.capacity() * sizeof(Zone);
+        for(const auto& zone : zoneList) bytes += zone.cols.capacity() * sizeof(ColumnRange);
+        return bytes;
     }
 
-    auto& table = currentDatabase->tables[tableName];
-    const auto& header = table.front();
+    // 第col列的值本身占用的字节数: 整数每个8字节, 其余为文本长度之和
+    size_t valueBytes(size_t col) const {
+        if(inlineInt[col]) return rowCount * SLOT_SIZE;
+        size_t bytes = 0;
+        for(size_t r = 0; r < rowCount; ++r) bytes += text(r, col).size();
+        return bytes;
+    }
 
-    for(size_t i = 1; i < table.size(); i++) {
-        bool match = true;
-        if(!conditions.empty()) {
-            const auto& row = table[i];
-            if(!evaluateConditions(row, header, conditions, tableName)) {
-                match = false;
-            }
+    // 文本列每行在行区中的偏移和长度
+    size_t slotBytes(size_t col) const { return inlineInt[col] ? 0 : rowCount * SLOT_SIZE; }
+
+    // 已删除、但文本还留在文本区中(下次压缩前)的行数
+    size_t deletedRows() const { return deadRows; }
+
+    // 更新只会放宽所在块的范围, 统计仍然保守正确
+    void set(size_t row, size_t col, const string& value) {
+        if(!inlineInt[col]) {
+            garbage += text(row, col).size();
         }
-        if(match) {
-            for(const auto& update : updates) {
-                auto it = find(header.begin(), header.end(), update.first);
-                if(it != header.end()) {
-                    size_t index = distance(header.begin(), it);
-                    string colType = currentDatabase->tableColumns[tableName][index].type;
-                    
-                    // 处理表达式
-                    string newValue = update.second;
-                    if(colType == "INTEGER" || colType == "FLOAT") {
-                        // 替换表达式中的列名为实际值
-                        string expr = newValue;
-                        for(const auto& col : currentDatabase->tableColumns[tableName]) {
-                            size_t pos = 0;
-                            while((pos = expr.find(col.name, pos)) != string::npos) {
-                                auto valIt = find(header.begin(), header.end(), col.name);
-                                if(valIt != header.end()) {
-                                    size_t valIndex = distance(header.begin(), valIt);
-                                    expr.replace(pos, col.name.length(), table[i][valIndex]);
-                                }
-                                pos += col.name.length();
-                            }
-                        }
-                        
-                        // 计算表达式结果
-                        try {
-                            istringstream iss(expr);
-                            float result = evaluateExpression(iss);
-                            if(colType == "INTEGER") {
-                                table[i][index] = to_string(static_cast<int>(result));
-                            } else {
-                                table[i][index] = to_string(result);
-                            }
-                        } catch(...) {
-                            cerr << "Invalid expression: " << expr << endl;
-                        }
-                    } else {
-                        table[i][index] = newValue;
-                    }
+        write(row, col, value);
+        if(zoned) includeCell(zoneList[row / BLOCK_ROWS], row, col);
+        compactIfNeeded();
+    }
+
+    const vector<Zone>& zones() const { return zoneList; }
+
+    // 把一行的值计入块统计
+    void includeRow(Zone& zone, size_t row) const {
+        for(size_t c = 0; c < columnCount(); ++c) includeCell(zone, row, c);
+    }
+
+    // 删除满足条件的行: 保留的行依次前移, 文本区的空洞在超过一半时压缩
+    template<typename Pred>
+    size_t removeIf(Pred pred) {
+        size_t width = rowWidth();
+        size_t kept = 0;
+        for(size_t r = 0; r < rowCount; ++r) {
+            if(pred(r)) {
+                for(size_t c = 0; c < columnCount(); ++c) {
+                    if(!inlineInt[c]) garbage += text(r, c).size();
                 }
+                continue;
+            }
+            if(kept != r) {
+                memmove(slots.data() + kept * width, slots.data() + r * width, width);
             }
+            ++kept;
         }
+        size_t removed = rowCount - kept;
+        rowCount = kept;
+        deadRows += removed;
+        slots.resize(kept * width);
+        compactIfNeeded();
+        if(zoned && removed > 0) rebuildZones();
+        return removed;
     }
-    save_database(*currentDatabase);
-}
 
-void deleteFromTable(const string& tableName, vector<string>& conditions)
-{
-    if(currentDatabase && currentDatabase->tables.find(tableName)!=currentDatabase->tables.end())
-    {
-        auto& table = currentDatabase->tables[tableName];
-        if(conditions.empty())
-        {
-            table.erase(table.begin()+1,table.end()); 
+    // 清空行但保留已分配的内存(扫描页时复用)
+    void clear() {
+        slots.clear();
+        arena.clear();
+        zoneList.clear();
+        rowCount = 0;
+        garbage = 0;
+        deadRows = 0;
+    }
+
+    // INTEGER值: 只接受整个都是整数的文本; 带小数部分或多余字符的值非法, 不截断
+    static bool parseInteger(const string& value, int64_t& out) {
+        try {
+            size_t used = 0;
+            out = stoll(value, &used);
+            return used == value.size();
+        } catch(...) {
+            return false;
         }
-        else
-        {
-            const auto& header = table.front();
-            for(size_t i = 1; i < table.size();) // 移除循环变量的递增
-            {
-                bool match = false;  
-                auto row = table[i];
-                if(conditions.empty()||evaluateConditions(row, header, conditions, tableName)) {
-                    match = true;
-                }
-                if(match) {
-                    table.erase(table.begin() + i);
-                } else {
-                    i++; 
-                }
-            }
+    }
+
+private:
+    static const size_t SLOT_SIZE = 8;
+
+    vector<char> inlineInt;  // 每列是否为内联整数(INTEGER和DECIMAL)
+    vector<char> kinds;  // 每列的存储类别
+    struct DecimalSpec {
+        char precision, scale;
+    };
+    vector<DecimalSpec> decimals;  // DECIMAL列的精度和小数位数, 其它列为0
+    vector<char> slots;  // 行区: rowCount * rowWidth 字节
+    vector<char> arena;  // 文本区
+    size_t rowCount = 0;
+    size_t garbage = 0;  // 文本区中已不被引用的字节数
+    size_t deadRows = 0;  // 自上次压缩以来删除的行数
+    bool zoned = false;
+    vector<Zone> zoneList;  // 第k块统计覆盖行[k*BLOCK_ROWS, (k+1)*BLOCK_ROWS)
+
+    void includeCell(Zone& zone, size_t row, size_t col) const {
+        if(inlineInt[col]) zone.cols[col].include(integer(row, col));
+        else zone.includeValue(col, kinds[col], text(row, col));
+    }
+
+    // 删除行后块边界移动, 整体重建
+    void rebuildZones() {
+        zoneList.clear();
+        for(size_t r = 0; r < rowCount; ++r) {
+            if(r % BLOCK_ROWS == 0) zoneList.emplace_back(columnCount());
+            zoneList.back().rows++;
+            includeRow(zoneList.back(), r);
         }
-        save_database(*currentDatabase);
     }
-}
 
-void save_database(const Database& db) {
-    ofstream file(db.name+".db");
-    if(db.tables.empty()) return;
-    
-    for(const auto& table : db.tables) {
-        file << "TABLE " << " " << table.first << endl;
-        
-        // 先写入列名和类型
-        const auto& columns = db.tableColumns.at(table.first);
-        for(size_t i = 0; i < columns.size(); ++i) {
-            file << columns[i].name << " " << columns[i].type;
-            if(i < columns.size() - 1) {
-                file << " ";
+    char* slot(size_t row, size_t col) { return slots.data() + row * rowWidth() + col * SLOT_SIZE; }
+    const char* slot(size_t row, size_t col) const { return slots.data() + row * rowWidth() + col * SLOT_SIZE; }
+
+    void write(size_t row, size_t col, string_view value) {
+        if(kinds[col] == 'D') {
+            DecimalValue d;
+            if(!parseDecimal(value, decimals[col].scale, d)) {
+                throw runtime_error("Invalid DECIMAL value: " + string(value));
             }
+            if(!decimalFits(d.rounded, decimals[col].precision)) {
+                throw runtime_error("Value " + string(value) + " out of range for DECIMAL(" + to_string(decimals[col].precision) + "," + to_string(decimals[col].scale) + ")");
+            }
+            memcpy(slot(row, col), &d.rounded, sizeof(d.rounded));
+            return;
         }
-        file << endl;
-        
-        // 写入数据
-        for(size_t i = 1; i < table.second.size(); ++i) {
-            const auto& row = table.second[i];
-            for(size_t j = 0; j < row.size(); ++j) {
-                file << row[j];
-                if(j < row.size() - 1) {
-                    file << " ";
-                }
+        if(inlineInt[col]) {
+            int64_t v;
+            if(!parseInteger(string(value), v)) {
+                throw runtime_error("Invalid INTEGER value: " + string(value));
             }
-            file << endl;
+            memcpy(slot(row, col), &v, sizeof(v));
+            return;
         }
-        file << "end" << endl;
+        writeText(row, col, value);
     }
-}
 
-void load_database(const string& db) {
-    ifstream file(db);
-    if (!file.is_open()) {
-        cerr << "Unable to open file: " << db << endl;
-        return;
+    void writeText(size_t row, size_t col, string_view value) {
+        if(arena.size() + value.size() > numeric_limits<uint32_t>::max()) {
+            throw runtime_error("Table text area exceeds 4 GB");
+        }
+        uint32_t off = static_cast<uint32_t>(arena.size());
+        uint32_t len = static_cast<uint32_t>(value.size());
+        arena.insert(arena.end(), value.begin(), value.end());
+        memcpy(slot(row, col), &off, 4);
+        memcpy(slot(row, col) + 4, &len, 4);
     }
-    string dbName = db.substr(0, db.find_last_of('.'));
-    currentDatabase = &databases[dbName];
-    currentDatabase->name = dbName;
-    string line, current_table;
-    bool isFirstRow = true;
-    
-    while(getline(file, line)) {
-        if(line.substr(0,5) == "TABLE") {
-            current_table = line.substr(7);
-            currentDatabase->tables[current_table] = {};
-            isFirstRow = true;
+
+    void compactIfNeeded() {
+        if(garbage < 4096 || garbage * 2 < arena.size()) return;
+        vector<char> fresh;
+        fresh.reserve(arena.size() - garbage);
+        for(size_t r = 0; r < rowCount; ++r) {
+            for(size_t c = 0; c < columnCount(); ++c) {
+                if(inlineInt[c]) continue;
+                string_view v = text(r, c);
+                uint32_t off = static_cast<uint32_t>(fresh.size());
+                fresh.insert(fresh.end(), v.begin(), v.end());
+                memcpy(slot(r, c), &off, 4);
+            }
         }
-        else if(line == "end") {
-            isFirstRow = true;
-            continue;
+        arena.swap(fresh);
+        garbage = 0;
+        deadRows = 0;
+    }
+};
+
+const size_t PAGE_SIZE = 4096;  // 页文件中每页的固定大小
+
+//读溢出文件(<数据库>.<表>.ov)中放在页外的长值; 第i个值读到自己的缓冲里, 解码下一条记录前有效
+class OverflowReader {
+public:
+    explicit OverflowReader(string path) : path(std::move(path)) {}
+
+    string_view read(size_t field, uint64_t offset, uint32_t length) {
+        if(!in.is_open()) {
+            in.open(path, ios::binary);
+            if(!in.is_open()) throw runtime_error("Unable to open overflow file: " + path);
         }
-        else if(isFirstRow) {
-            // 处理列名和类型行
-            istringstream iss(line);
-            vector<string> columnNames;
-            vector<Column> tableColumns;
-            string name, type;
-            
-            while(iss >> name >> type) {
-                columnNames.push_back(name);
-                tableColumns.push_back({name, type});
-            }
-            
-            currentDatabase->tables[current_table].push_back(columnNames);
-            currentDatabase->tableColumns[current_table] = tableColumns;
-            isFirstRow = false;
+        if(values.size() <= field) values.resize(field + 1);  // deque加长不移动已有的缓冲
+        string& value = values[field];
+        value.resize(length);
+        in.clear();
+        in.seekg(static_cast<streamoff>(offset));
+        if(length && !in.read(&value[0], length)) throw runtime_error("Overflow file is truncated: " + path);
+        return value;
+    }
+
+private:
+    string path;
+    ifstream in;
+    deque<string> values;
+};
+
+//槽式页: 页头为[槽数 u16][记录区起点 u16], 槽数组(偏移 u16, 长度 u16)向后增长, 记录从页尾向前增长
+struct Page {
+    char data[PAGE_SIZE];
+
+    static const size_t HEADER_SIZE = 4;
+    static const size_t SLOT_SIZE = 4;
+    static const size_t MAX_RECORD = PAGE_SIZE - HEADER_SIZE - SLOT_SIZE;
+    static constexpr uint16_t OVERFLOW = 0xFFFF;  // 页内的值不超过一页, 不会有这个长度
+    static const size_t OVERFLOW_REF = 12;        // 页外的值在记录中占的字节: 偏移和长度
+
+    void init() {
+        memset(data, 0, PAGE_SIZE);
+        setU16(0, 0);
+        setU16(2, PAGE_SIZE);
+    }
+
+    uint16_t slotCount() const { return getU16(0); }
+
+    // 插入一条记录, 空间不足时返回false
+    bool insert(string_view record) {
+        size_t count = slotCount();
+        size_t freeEnd = getU16(2);
+        size_t slotEnd = HEADER_SIZE + (count + 1) * SLOT_SIZE;
+        if(slotEnd + record.size() > freeEnd) {
+            return false;
         }
-        else {
-            // 处理数据行
-            vector<string> values;
-            string value;
-            istringstream iss(line);
-            bool inQuotes = false;
-            string currentValue;
-            
-            for(char c : line) {
-                if(c == '\'') {
-                    inQuotes = !inQuotes;
-                    currentValue += c;
-                }
-                else if(c == ' ' && !inQuotes) {
-                    if(!currentValue.empty()) {
-                        values.push_back(currentValue);
-                        currentValue.clear();
-                    }
-                }
-                else {
-                    currentValue += c;
-                }
+        freeEnd -= record.size();
+        memcpy(data + freeEnd, record.data(), record.size());
+        setU16(HEADER_SIZE + count * SLOT_SIZE, static_cast<uint16_t>(freeEnd));
+        setU16(HEADER_SIZE + count * SLOT_SIZE + 2, static_cast<uint16_t>(record.size()));
+        setU16(0, static_cast<uint16_t>(count + 1));
+        setU16(2, static_cast<uint16_t>(freeEnd));
+        return true;
+    }
+
+    // 解码第slot条记录为一行
+    vector<string> row(size_t slot, OverflowReader& overflow) const {
+        vector<string_view> views;
+        fields(slot, views, overflow);
+        return vector<string>(views.begin(), views.end());
+    }
+
+    // 不复制地取出第slot条记录的各个值, 只在页被钉住期间有效; 页外的值在overflow的缓冲中
+    void fields(size_t slot, vector<string_view>& values, OverflowReader& overflow) const {
+        size_t off = getU16(HEADER_SIZE + slot * SLOT_SIZE);
+        size_t end = off + getU16(HEADER_SIZE + slot * SLOT_SIZE + 2);
+        values.clear();
+        while(off < end) {
+            size_t len = getU16(off);
+            if(len == OVERFLOW) {
+                uint64_t at;
+                uint32_t length;
+                memcpy(&at, data + off + 2, 8);
+                memcpy(&length, data + off + 10, 4);
+                values.push_back(overflow.read(values.size(), at, length));
+                off += 2 + OVERFLOW_REF;
+                continue;
             }
-            if(!currentValue.empty()) {
-                values.push_back(currentValue);
+            values.emplace_back(data + off + 2, len);
+            off += 2 + len;
+        }
+    }
+
+    // 记录格式: 每个值为[长度 u16][字节]; 长度为OVERFLOW时值在溢出文件中, 之后是[偏移 u64][长度 u32]
+    // 整行放不进一页时从最长的值起依次移到页外, 直到放得下; spill把值追加到溢出文件并返回偏移
+    // 编码到record末尾; record可以是语句临时内存上的字符串
+    template<typename Row, typename Record, typename Spill>
+    static Record encodeRow(const Row& row, Record record, Spill spill) {
+        vector<bool> outside(row.size(), false);
+        size_t size = encodedSize(row);
+        while(size > MAX_RECORD) {
+            size_t longest = row.size();
+            for(size_t i = 0; i < row.size(); ++i) {
+                if(!outside[i] && row[i].size() > OVERFLOW_REF && (longest == row.size() || row[i].size() > row[longest].size())) longest = i;
             }
-            
-            if(!values.empty()) {
-                currentDatabase->tables[current_table].push_back(values);
+            if(longest == row.size()) break;  // 由调用者用fits()预先拒绝
+            outside[longest] = true;
+            size -= row[longest].size() - OVERFLOW_REF;
+        }
+        for(size_t i = 0; i < row.size(); ++i) {
+            const auto& value = row[i];
+            if(outside[i]) {
+                uint64_t at = spill(string_view(value.data(), value.size()));
+                uint32_t length = static_cast<uint32_t>(value.size());
+                record.append(reinterpret_cast<const char*>(&OVERFLOW), 2);
+                record.append(reinterpret_cast<const char*>(&at), 8);
+                record.append(reinterpret_cast<const char*>(&length), 4);
+                continue;
             }
+            uint16_t len = static_cast<uint16_t>(value.size());
+            record.append(reinterpret_cast<const char*>(&len), 2);
+            record.append(value.data(), len);
         }
+        return record;
     }
-    file.close();
-}
-//专门的比较函数
-bool compareValues(const string& value1, const string& value2, const string& type, const string& op) {
-    if(type == "INTEGER") {
-        int v1 = stoi(value1);
-        int v2 = stoi(value2);
-        if(op == "=") return v1 == v2;
-        if(op == "<") return v1 < v2;
-        if(op == ">") return v1 > v2;
-        if(op =="!=") return v1!=v2;
+
+    template<typename Row>
+    static size_t encodedSize(const Row& row) {
+        size_t size = 0;
+        for(const auto& value : row) size += 2 + value.size();
+        return size;
     }
-    else if(type == "FLOAT") {
-        
-        string val1 = value1;
-        string val2 = value2;
-        if(val1.front() == '\'') val1 = val1.substr(1, val1.length()-2);
-        if(val2.front() == '\'') val2 = val2.substr(1, val2.length()-2);
-        
-        float v1 = stof(val1);
-        float v2 = stof(val2);
-        if(op == "=") return v1 == v2;
-        if(op == "<") return v1 < v2;
-        if(op == ">") return v1 > v2;
-        if(op =="!=") return v1!=v2;
+
+    // 长值都移到页外后这一行能放进一页
+    template<typename Row>
+    static bool fits(const Row& row) {
+        size_t size = 0;
+        for(const auto& value : row) size += 2 + min<size_t>(value.size(), OVERFLOW_REF);
+        return size <= MAX_RECORD;
     }
-    else { 
-        if(op == "=") return value1 == value2;
-        if(op == "<") return value1 < value2;
-        if(op == ">") return value1 > value2;
-        if(op =="!=") return value1!=value2;
+
+private:
+    uint16_t getU16(size_t off) const { uint16_t v; memcpy(&v, data + off, 2); return v; }
+    void setU16(size_t off, uint16_t v) { memcpy(data + off, &v, 2); }
+};
+
+//缓冲池: 固定数量的页帧, 被钉住的页不会被淘汰, 其余按LRU淘汰(脏页先写回)
+//并行执行语句时多个线程共用缓冲池, 公开的操作都在锁内完成; 钉住的页由钉住它的线程独占使用
+class BufferPool {
+public:
+    explicit BufferPool(size_t capacity = 256) : capacity(capacity) {}
+
+    uint64_t bytesRead = 0, bytesWritten = 0;  // 页文件累计读写字节数
+
+    void setCapacity(size_t n) { capacity = max<size_t>(n, 2); }
+    size_t getCapacity() const { return capacity; }
+
+    // 文件中的页数(包括尚未写回的新页)
+    size_t pageCount(const string& file) {
+        lock_guard<mutex> lock(latch);
+        return pageCountLocked(file);
     }
-    return false;
-}
-//表达式计算函数
-float evaluateExpression(istringstream& iss) {
-    stack<float> values;
-    stack<char> ops;
-    
-    char c;
-    while(iss.get(c)) {
-        if(isspace(c)) continue;
-        
-        if(isdigit(c) || c == '.') {
-            iss.unget();
-            float val;
-            iss >> val;
-            values.push(val);
-        } else if(c == '(') {
-            ops.push(c);
-        } else if(c == ')') {
-            while(!ops.empty() && ops.top() != '(') {
-                float val2 = values.top(); values.pop();
-                float val1 = values.top(); values.pop();
-                char op = ops.top(); ops.pop();
-                values.push(applyOp(val1, val2, op));
-            }
-            if(!ops.empty()) ops.pop();
-        } else if(c == '+' || c == '-' || c == '*' || c == '/') {
-            while(!ops.empty() && precedence(ops.top()) >= precedence(c)) {
-                float val2 = values.top(); values.pop();
-                float val1 = values.top(); values.pop();
-                char op = ops.top(); ops.pop();
-                values.push(applyOp(val1, val2, op));
-            }
-            ops.push(c);
+
+    Page* pin(const string& file, size_t pageNo) {
+        lock_guard<mutex> lock(latch);
+        string key = frameKey(file, pageNo);
+        auto it = pageTable.find(key);
+        if(it != pageTable.end()) {
+            Frame& f = *frames[it->second];
+            if(f.pinCount++ == 0) lru.erase(f.lruPos);
+            return &f.page;
         }
+        size_t idx = grabFrame();
+        Frame& f = *frames[idx];
+        f.file = file;
+        f.pageNo = pageNo;
+        f.pinCount = 1;
+        f.dirty = false;
+        readPage(f);
+        pageTable[key] = idx;
+        return &f.page;
     }
-    
-    while(!ops.empty()) {
-        float val2 = values.top(); values.pop();
-        float val1 = values.top(); values.pop();
-        char op = ops.top(); ops.pop();
-        values.push(applyOp(val1, val2, op));
-    }
-    
-    return values.top();
-}
 
-float applyOp(float a, float b, char op) {
-    switch(op) {
-        case '+': return a + b;
-        case '-': return a - b;
-        case '*': return a * b;
-        case '/': return a / b;
+    void unpin(const string& file, size_t pageNo, bool dirty) {
+        lock_guard<mutex> lock(latch);
+        auto it = pageTable.find(frameKey(file, pageNo));
+        if(it == pageTable.end()) return;
+        Frame& f = *frames[it->second];
+        f.dirty = f.dirty || dirty;
+        if(f.pinCount > 0 && --f.pinCount == 0) {
+            lru.push_front(it->second);
+            f.lruPos = lru.begin();
+        }
     }
-    return 0;
-}
 
-int precedence(char op) {
-    if(op == '+' || op == '-') return 1;
-    if(op == '*' || op == '/') return 2;
-    return 0;
-}
-//处理WHERE条件
-bool evaluateConditions(const vector<string>& row, const vector<string>& header, const vector<string>& conditions, const string& tableName) {
-    bool result = true; // 初始设为 true，便于处理单一条件的情况
-    bool cond1 = false, cond2 = false;
-    string logicalOp;
+    // 在文件末尾追加一页, 返回的页已被钉住
+    Page* newPage(const string& file, size_t& pageNo) {
+        lock_guard<mutex> lock(latch);
+        pageNo = pageCountLocked(file);
+        size_t idx = grabFrame();
+        Frame& f = *frames[idx];
+        f.file = file;
+        f.pageNo = pageNo;
+        f.pinCount = 1;
+        f.dirty = true;
+        f.page.init();
+        pageTable[frameKey(file, pageNo)] = idx;
+        pageCounts[file] = pageNo + 1;
+        return &f.page;
+    }
 
-    vector<string> condParts = conditions;
+    // 写回文件的所有脏页
+    void flush(const string& file) {
+        lock_guard<mutex> lock(latch);
+        for(auto& f : frames) {
+            if(f->dirty && f->file == file) {
+                writePage(*f);
+            }
+        }
+        auto it = streams.find(file);
+        if(it != streams.end()) it->second->flush();
+    }
 
-    // 处理逻辑运算符 AND 或 OR
-    if (conditions.size() > 3) {
-        logicalOp = conditions[3];
-        condParts.erase(condParts.begin() + 3); // 移除逻辑运算符
+    // 丢弃文件的所有缓存页(不写回), 用于文件被整体重写或删除时
+    void discard(const string& file) {
+        lock_guard<mutex> lock(latch);
+        for(size_t i = 0; i < frames.size(); ++i) {
+            Frame& f = *frames[i];
+            if(f.file != file || f.file.empty()) continue;
+            if(f.pinCount == 0) lru.erase(f.lruPos);
+            pageTable.erase(frameKey(f.file, f.pageNo));
+            f.file.clear();
+            f.pinCount = 0;
+            f.dirty = false;
+            freeFrames.push_back(i);
+        }
+        pageCounts.erase(file);
+        streams.erase(file);
     }
 
-    // 处理条件1
-    cond1 = evaluateSingleCondition(row, header, condParts[0], condParts[1], condParts[2], tableName);
+private:
+    struct Frame {
+        string file;
+        size_t pageNo = 0;
+        int pinCount = 0;
+        bool dirty = false;
+        list<size_t>::iterator lruPos;
+        Page page;
+    };
+
+    size_t capacity;
+    mutex latch;
+    vector<unique_ptr<Frame>> frames;
+    vector<size_t> freeFrames;
+    list<size_t> lru;  // 未被钉住的帧, 表头为最近使用
+    unordered_map<string, size_t> pageTable;
+    unordered_map<string, size_t> pageCounts;
+    unordered_map<string, unique_ptr<fstream>> streams;
 
-    // 处理条件2（如果有）
-    if (condParts.size() > 3) {
-        cond2 = evaluateSingleCondition(row, header, condParts[3], condParts[4], condParts[5], tableName);
+    size_t pageCountLocked(const string& file) {
+        auto it = pageCounts.find(file);
+        if(it != pageCounts.end()) return it->second;
+        ifstream in(file, ios::binary | ios::ate);
+        size_t n = in.is_open() ? static_cast<size_t>(in.tellg()) / PAGE_SIZE : 0;
+        pageCounts[file] = n;
+        return n;
     }
 
-    // 应用逻辑运算符
-    if (!logicalOp.empty()) {
-        if (logicalOp == "AND") {
-            result = cond1 && cond2;
-        } else if (logicalOp == "OR") {
-            result = cond1 || cond2;
+    static string frameKey(const string& file, size_t pageNo) {
+        return file + "#" + to_string(pageNo);
+    }
+
+    size_t grabFrame() {
+        if(!freeFrames.empty()) {
+            size_t idx = freeFrames.back();
+            freeFrames.pop_back();
+            return idx;
         }
-    } else {
-        result = cond1;
+        if(frames.size() < capacity) {
+            frames.push_back(make_unique<Frame>());
+            return frames.size() - 1;
+        }
+        if(lru.empty()) {
+            throw runtime_error("Buffer pool exhausted: all pages are pinned");
+        }
+        size_t idx = lru.back();
+        lru.pop_back();
+        Frame& victim = *frames[idx];
+        if(victim.dirty) writePage(victim);
+        pageTable.erase(frameKey(victim.file, victim.pageNo));
+        return idx;
     }
 
-    return result;
-}
+    fstream& stream(const string& file) {
+        auto it = streams.find(file);
+        if(it != streams.end()) return *it->second;
+        ofstream(file, ios::binary | ios::app).close();  // 文件不存在时先创建
+        auto fs = make_unique<fstream>(file, ios::binary | ios::in | ios::out);
+        if(!fs->is_open()) {
+            throw runtime_error("Unable to open page file: " + file);
+        }
+        return *(streams[file] = move(fs));
+    }
 
-bool evaluateSingleCondition(const vector<string>& row, const vector<string>& header, const string& columnName, const string& op, const string& value, const string& tableName) {
-    auto it = find(header.begin(), header.end(), columnName);
-    if (it != header.end()) {
-        size_t index = distance(header.begin(), it);
-        string colType = currentDatabase->tableColumns[tableName][index].type;
-        return compareValues(row[index], value, colType, op);
-    } else {
-        cerr << "Column " << columnName << " does not exist" << endl;
-        return false;
+    void readPage(Frame& f) {
+        fstream& fs = stream(f.file);
+        fs.clear();
+        fs.seekg(static_cast<streamoff>(f.pageNo * PAGE_SIZE));
+        if(!fs.read(f.page.data, PAGE_SIZE)) {
+            f.page.init();
+            fs.clear();
+            return;
+        }
+        bytesRead += PAGE_SIZE;
     }
-}
 
+    void writePage(Frame& f) {
+        fstream& fs = stream(f.file);
+        fs.clear();
+        fs.seekp(static_cast<streamoff>(f.pageNo * PAGE_SIZE));
+        fs.write(f.page.data, PAGE_SIZE);
+        bytesWritten += PAGE_SIZE;
+        f.dirty = false;
+    }
 };
-//移除两端的空白字符
-string trim(const std::string& str) {
-    size_t first = str.find_first_not_of(" \t\n\r");
-    if (first == std::string::npos) return "";
-    size_t last = str.find_last_not_of(" \t\n\r");
-    return str.substr(first, last - first + 1);
-}
 
-void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
-{
-    // ****首先清空输出文件****
-    ofstream clearFile(outputFile, ios::trunc);
-    clearFile.close();
+//********** 性能剖析(--profile) **********
+//每条语句记录: 各阶段耗时、扫描/输出行数、读写字节数; 运行结束时输出汇总表和Chrome trace-event JSON
+enum class Phase { PARSE, LOAD, SCAN, FILTER, JOIN, OUTPUT, SAVE, EXECUTE, COUNT };
+static const char* const PHASE_NAMES[] = {"parse", "load", "scan", "filter", "join", "output", "save", "execute"};
 
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Unable to open file: " << filename << endl;
-        return;
+class Profiler {
+public:
+    explicit Profiler(const BufferPool& pool) : pool(pool), origin(chrono::steady_clock::now()) {}
+
+    bool enabled = false;
+
+    // 语句开始时打开根阶段parse: 没有落在其他阶段里的时间都算作解析
+    void beginStatement(const string& sql, int line) {
+        Statement s;
+        s.line = line;
+        s.sql = sql;
+        s.startUs = now();
+        s.readBase = bytesRead();
+        s.writeBase = bytesWritten();
+        statements.push_back(move(s));
+        open.clear();
+        inStatement = true;
+        beginPhase(Phase::PARSE);
     }
 
-    string line;
-    string sqlCommand;
-    int lineNum = 0;
-    
-    while (getline(file, line)) {
-        lineNum++;
-        // sqlCommand += line + " ";
-        
-        // if (line.find(';')!=string::npos) {
-        //     sqlCommand=trim(sqlCommand);
-        //     sqlCommand.pop_back();
-        size_t pos=0;
-        while(pos<line.length())
+    void endStatement() {
+        while(!open.empty()) endPhase();
+        Statement& s = statements.back();
+        s.durUs = now() - s.startUs;
+        s.bytesRead = bytesRead() - s.readBase;
+        s.bytesWritten = bytesWritten() - s.writeBase;
+        inStatement = false;
+    }
+
+    // 阶段可以嵌套, 汇总表记录独占时间(扣除子阶段), trace记录完整区间
+    void beginPhase(Phase phase) {
+        if(!inStatement) return;
+        open.push_back({phase, now(), 0});
+    }
+
+    void endPhase() {
+        if(open.empty()) return;
+        OpenPhase top = open.back();
+        open.pop_back();
+        double dur = now() - top.startUs;
+        statements.back().phaseUs[static_cast<size_t>(top.phase)] += dur - top.childUs;
+        if(!open.empty()) open.back().childUs += dur;
+        if(spans.size() < MAX_SPANS) {
+            spans.push_back({top.phase, top.startUs, dur, statements.size() - 1});
+        } else {
+            droppedSpans++;
+        }
+    }
+
+    void addScanned(size_t rows) { if(active()) statements.back().rowsScanned += rows; }
+    void addEmitted(size_t rows) { if(active()) statements.back().rowsEmitted += rows; }
+    void addRead(uint64_t bytes) { otherRead += bytes; }
+    void addWritten(uint64_t bytes) { otherWritten += bytes; }
+
+    void writeSummary(ostream& out) const {
+        const int PHASES = static_cast<int>(Phase::COUNT);
+        out << fixed << setprecision(3);
+        out << left << setw(6) << "line" << right << setw(11) << "total_ms";
+        for(int p = 0; p < PHASES; ++p) out << setw(10) << PHASE_NAMES[p];
+        out << setw(10) << "scanned" << setw(10) << "emitted" << setw(12) << "read_B" << setw(12) << "written_B" << "  statement" << endl;
+        Statement total;
+        for(const auto& s : statements) {
+            writeSummaryRow(out, to_string(s.line), s);
+            total.durUs += s.durUs;
+            for(int p = 0; p < PHASES; ++p) total.phaseUs[p] += s.phaseUs[p];
+            total.rowsScanned += s.rowsScanned;
+            total.rowsEmitted += s.rowsEmitted;
+            total.bytesRead += s.bytesRead;
+            total.bytesWritten += s.bytesWritten;
+        }
+        total.sql = to_string(statements.size()) + " statements";
+        writeSummaryRow(out, "total", total);
+        if(droppedSpans > 0) {
+            out << "trace truncated: " << droppedSpans << " spans dropped" << endl;
+        }
+    }
+
+    // Chrome trace-event格式(可在chrome://tracing或Perfetto中打开): 语句和阶段都是完整事件("ph":"X")
+    void writeTrace(const string& file) const {
+        ofstream out(file);
+        if(!out.is_open()) {
+            cerr << "Unable to open file: " << file << endl;
+            return;
+        }
+        out << fixed << setprecision(3);
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        bool first = true;
+        for(const auto& s : statements) {
+            out << (first ? "\n" : ",\n") << "{\"name\": \"" << jsonEscape(s.sql) << "\", \"cat\": \"statement\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+                << ", \"ts\": " << s.startUs << ", \"dur\": " << s.durUs
+                << ", \"args\": {\"line\": " << s.line << ", \"rows_scanned\": " << s.rowsScanned << ", \"rows_emitted\": " << s.rowsEmitted
+                << ", \"bytes_read\": " << s.bytesRead << ", \"bytes_written\": " << s.bytesWritten << "}}";
+            first = false;
+        }
+        for(const auto& span : spans) {
+            out << (first ? "\n" : ",\n") << "{\"name\": \"" << PHASE_NAMES[static_cast<size_t>(span.phase)] << "\", \"cat\": \"phase\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+                << ", \"ts\": " << span.startUs << ", \"dur\": " << span.durUs
+                << ", \"args\": {\"line\": " << statements[span.statement].line << "}}";
+            first = false;
+        }
+        out << "\n]}\n";
+    }
+
+private:
+    static const size_t MAX_SPANS = 1 << 20;  // trace区间上限, 防止超大表按块计时时文件失控
+
+    struct Statement {
+        int line = 0;
+        string sql;
+        double startUs = 0, durUs = 0;
+        double phaseUs[static_cast<size_t>(Phase::COUNT)] = {};
+        uint64_t rowsScanned = 0, rowsEmitted = 0;
+        uint64_t bytesRead = 0, bytesWritten = 0;
+        uint64_t readBase = 0, writeBase = 0;
+    };
+    struct OpenPhase {
+        Phase phase;
+        double startUs;
+        double childUs;
+    };
+    struct Span {
+        Phase phase;
+        double startUs, durUs;
+        size_t statement;
+    };
+
+    const BufferPool& pool;
+    chrono::steady_clock::time_point origin;
+    vector<Statement> statements;
+    vector<OpenPhase> open;
+    vector<Span> spans;
+    size_t droppedSpans = 0;
+    bool inStatement = false;
+    atomic<uint64_t> otherRead{0}, otherWritten{0};  // 页文件以外的读写: 数据库文件、块统计文件、输出文件
+
+    bool active() const { return inStatement; }
+    uint64_t bytesRead() const { return pool.bytesRead + otherRead; }
+    uint64_t bytesWritten() const { return pool.bytesWritten + otherWritten; }
+
+    double now() const {
+        return chrono::duration<double, micro>(chrono::steady_clock::now() - origin).count();
+    }
+
+    static void writeSummaryRow(ostream& out, const string& label, const Statement& s) {
+        out << left << setw(6) << label << right << setw(11) << s.durUs / 1000.0;
+        for(size_t p = 0; p < static_cast<size_t>(Phase::COUNT); ++p) out << setw(10) << s.phaseUs[p] / 1000.0;
+        string sql = s.sql.size() > 60 ? s.sql.substr(0, 57) + "..." : s.sql;
+        out << setw(10) << s.rowsScanned << setw(10) << s.rowsEmitted << setw(12) << s.bytesRead << setw(12) << s.bytesWritten << "  " << sql << endl;
+    }
+
+    static string jsonEscape(const string& text) {
+        string escaped;
+        for(char c : text) {
+            if(c == '"' || c == '\\') {
+                escaped += '\\';
+                escaped += c;
+            } else if(static_cast<unsigned char>(c) < 0x20) {
+                escaped += ' ';
+            } else {
+                escaped += c;
+            }
+        }
+        return escaped;
+    }
+};
+
+//作用域内计时一个阶段; 未开启剖析时只多一次判断
+class ProfileScope {
+public:
+    ProfileScope(Profiler& profiler, Phase phase) : profiler(profiler), on(profiler.enabled) {
+        if(on) profiler.beginPhase(phase);
+    }
+    ~ProfileScope() {
+        if(on) profiler.endPhase();
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler& profiler;
+    bool on;
+};
+
+//整条语句计时
+class StatementScope {
+public:
+    StatementScope(Profiler& profiler, const string& sql, int line) : profiler(profiler), on(profiler.enabled) {
+        if(on) profiler.beginStatement(sql, line);
+    }
+    ~StatementScope() {
+        if(on) profiler.endStatement();
+    }
+    StatementScope(const StatementScope&) = delete;
+    StatementScope& operator=(const StatementScope&) = delete;
+
+private:
+    Profiler& profiler;
+    bool on;
+};
+
+//每条语句的临时内存: 解析出的值、拼出的表达式、连接哈希表的结点等短命对象从这里顺序分配, 不逐个释放, 语句结束时整块归还
+//先用当前线程的一块固定缓冲区, 用完才向堆申请; 同一线程中嵌套的语句沿用外层的
+const size_t STATEMENT_ARENA_BYTES = 64 * 1024;
+
+class StatementArena {
+public:
+    StatementArena() {
+        if(current) return;
+        alignas(max_align_t) static thread_local char buffer[STATEMENT_ARENA_BYTES];
+        resource.emplace(buffer, sizeof(buffer));
+        current = &*resource;
+    }
+    ~StatementArena() {
+        if(resource) current = nullptr;
+    }
+    StatementArena(const StatementArena&) = delete;
+    StatementArena& operator=(const StatementArena&) = delete;
+
+    // 当前语句的临时内存; 不在语句中(如库接口直接执行查询)时为普通的堆
+    static pmr::memory_resource* get() { return current ? current : pmr::get_default_resource(); }
+
+private:
+    optional<pmr::monotonic_buffer_resource> resource;
+    static inline thread_local pmr::memory_resource* current = nullptr;
+};
+
+using ArenaRow = pmr::vector<pmr::string>;  // 语句临时内存上的一行值
+
+//********** 内存记账(--memory-limit / --query-memory-limit) **********
+//表的行存储、连接的哈希表和排序缓冲向MemoryTracker登记占用的字节数: 全局用量是所有登记之和, 每条语句的工作内存另按线程累计
+//表的行存储只记账不拒绝, 它挤占的是留给语句的内存; 哈希连接的哈希表超出预算时改为分区落盘, 其它工作内存超出时语句报错
+const size_t SPILL_PARTITIONS = 16;  // 哈希连接落盘时两侧各分成的分区数
+const size_t MAX_SPILL_DEPTH = 4;    // 读回仍然超出预算的分区最多再分的层数
+const size_t MERGE_FAN_IN = 64;      // 有序段达到这个数时先归并成一段, 限制同时打开的临时文件数
+const size_t HASH_ENTRY_BYTES = 48;  // 哈希表中每行的估计开销: 结点、桶和链上的下一行
+
+class MemoryLimitError : public runtime_error {
+public:
+    using runtime_error::runtime_error;
+};
+
+//共享扫描中途出错: 第failed条语句已写出部分结果, 从第resume条起的语句还没有写出
+class SharedScanError : public runtime_error {
+public:
+    SharedScanError(const string& what, size_t failed, size_t resume) : runtime_error(what), failed(failed), resume(resume) {}
+    size_t failed, resume;
+};
+
+class MemoryTracker {
+public:
+    size_t globalLimit = 0;  // 所有登记之和的上限, 0为不限
+    size_t queryLimit = 0;   // 一条语句工作内存的上限, 0为不限
+
+    // 为当前语句登记bytes字节; 超过任一上限时不登记, 返回false
+    bool tryReserve(size_t bytes) {
+        if(queryLimit && queryUsed + bytes > queryLimit) return false;
+        size_t now = used.fetch_add(bytes) + bytes;
+        if(globalLimit && now > globalLimit) {
+            used -= bytes;
+            return false;
+        }
+        queryUsed += bytes;
+        notePeak(now);
+        return true;
+    }
+
+    void release(size_t bytes) {
+        used -= bytes;
+        queryUsed -= bytes;
+    }
+
+    // 表的行存储: 记下这张表当前的字节数, 替换之前的登记, 为0时撤销
+    void chargeTable(const string& table, size_t bytes) {
+        lock_guard<mutex> lock(latch);
+        size_t& charged = tables[table];
+        used += bytes;
+        used -= charged;
+        charged = bytes;
+        if(bytes == 0) tables.erase(table);
+        notePeak(used);
+    }
+
+    // 一个算子因超出预算写了bytes字节的临时文件
+    void noteSpill(uint64_t bytes) {
+        spills++;
+        spilledBytes += bytes;
+    }
+
+    string limits() const {
+        string text;
+        if(queryLimit) text += "query limit " + to_string(queryLimit) + " bytes, " + to_string(queryUsed) + " in use";
+        if(globalLimit) text += string(text.empty() ? "" : "; ") + "global limit " + to_string(globalLimit) + " bytes, " + to_string(used) + " in use";
+        return text;
+    }
+
+    void writeSummary(ostream& out) const {
+        out << "memory: peak " << peak << " bytes";
+        if(spills) out << ", " << spills << " operators spilled " << spilledBytes << " bytes to disk";
+        out << endl;
+    }
+
+private:
+    atomic<size_t> used{0}, peak{0};
+    atomic<uint64_t> spills{0}, spilledBytes{0};
+    mutex latch;
+    unordered_map<string, size_t> tables;  // "数据库.表" -> 登记的字节数
+    static inline thread_local size_t queryUsed = 0;  // 语句在自己的线程上执行, 算子析构时归还, 语句结束时回到0
+
+    void notePeak(size_t now) {
+        size_t seen = peak;
+        while(now > seen && !peak.compare_exchange_weak(seen, now)) {}
+    }
+};
+
+//一个算子登记的工作内存: set把登记量调整为当前占用, 析构时归还
+class MemoryReservation {
+public:
+    MemoryReservation(MemoryTracker& tracker, string what) : tracker(tracker), what(std::move(what)) {}
+    ~MemoryReservation() { tracker.release(bytes); }
+    MemoryReservation(const MemoryReservation&) = delete;
+    MemoryReservation& operator=(const MemoryReservation&) = delete;
+
+    // 增加的部分超出上限时保持原来的登记, 返回false
+    bool trySet(size_t total) {
+        if(total > bytes && !tracker.tryReserve(total - bytes)) return false;
+        if(total < bytes) tracker.release(bytes - total);
+        bytes = total;
+        return true;
+    }
+
+    void set(size_t total) {
+        if(!trySet(total)) fail(total);
+    }
+
+    [[noreturn]] void fail(size_t total, const string& note = "") const {
+        throw MemoryLimitError("Memory limit exceeded: " + what + " needs " + to_string(total) + " bytes" + note + " (" + tracker.limits() + ")");
+    }
+
+private:
+    MemoryTracker& tracker;
+    string what;
+    size_t bytes = 0;
+};
+
+//落盘用的临时文件: tmpfile()创建, 关闭时自动删除; 记录为4字节长度加内容, 先顺序写完, 再从头顺序读
+class SpillFile {
+public:
+    explicit SpillFile(Profiler& profiler) : profiler(profiler), file(tmpfile()) {
+        if(!file) throw runtime_error("Cannot create temporary file for spilling");
+    }
+    ~SpillFile() { fclose(file); }
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    uint64_t bytes = 0;
+
+    void write(const string& record) {
+        uint32_t len = static_cast<uint32_t>(record.size());
+        if(fwrite(&len, 4, 1, file) != 1 || fwrite(record.data(), 1, len, file) != len) {
+            throw runtime_error("Cannot write temporary file for spilling");
+        }
+        bytes += 4 + len;
+        profiler.addWritten(4 + len);
+    }
+
+    void startReading() {
+        fflush(file);
+        fseek(file, 0, SEEK_SET);
+    }
+
+    bool read(string& record) {
+        uint32_t len;
+        if(fread(&len, 4, 1, file) != 1) return false;
+        record.resize(len);
+        if(len && fread(&record[0], 1, len, file) != len) {
+            throw runtime_error("Temporary spill file is truncated");
+        }
+        profiler.addRead(4 + len);
+        return true;
+    }
+
+private:
+    Profiler& profiler;
+    FILE* file;
+};
+
+//********** 统计信息(ANALYZE)与代价模型 **********
+const size_t HISTOGRAM_BUCKETS = 16;     // 等深直方图的桶数
+const size_t STATS_SAMPLE_ROWS = 10000;  // 直方图按蓄水池抽样的行数
+
+//单列统计: 不同值个数的估计和等深直方图
+struct ColumnStats {
+    uint64_t distinct = 0;
+    vector<string> bounds;  // 第b个桶的上界(升序), 每个桶的行数大致相同
+};
+
+//一张表的统计, 由ANALYZE收集, 存于<数据库>.<表>.st
+struct TableStats {
+    uint64_t rows = 0;
+    vector<ColumnStats> cols;
+
+    // 满足条件的行所占比例的估计
+    double selectivity(const Condition& cond) const {
+        if(cond.index == TableSchema::npos) return 0;
+        if(cond.index >= cols.size()) return guess(cond);
+        const ColumnStats& col = cols[cond.index];
+        double eq = col.distinct ? 1.0 / col.distinct : guess(cond);
+        switch(cond.cmp) {
+            case CmpOp::EQ: return eq;
+            case CmpOp::NE: return 1 - eq;
+            case CmpOp::LT: return fractionBelow(col, cond);
+            case CmpOp::GT: return max(0.0, 1 - fractionBelow(col, cond) - eq);
+            default: return 0;  // 不支持的运算符没有行满足
+        }
+    }
+
+    // 没有统计时的默认估计
+    static double guess(const Condition& cond) {
+        switch(cond.cmp) {
+            case CmpOp::EQ: return 0.1;
+            case CmpOp::NE: return 0.9;
+            case CmpOp::LT: case CmpOp::GT: return 1.0 / 3;
+            default: return cond.index == TableSchema::npos ? 0 : 1.0 / 3;
+        }
+    }
+
+    void write(ostream& out) const {
+        out.write(reinterpret_cast<const char*>(&rows), 8);
+        for(const auto& col : cols) {
+            out.write(reinterpret_cast<const char*>(&col.distinct), 8);
+            uint32_t n = static_cast<uint32_t>(col.bounds.size());
+            out.write(reinterpret_cast<const char*>(&n), 4);
+            for(const auto& bound : col.bounds) {
+                uint32_t len = static_cast<uint32_t>(bound.size());
+                out.write(reinterpret_cast<const char*>(&len), 4);
+                out.write(bound.data(), len);
+            }
+        }
+    }
+
+    bool read(istream& in, size_t columnCount) {
+        cols.assign(columnCount, ColumnStats());
+        if(!in.read(reinterpret_cast<char*>(&rows), 8)) return false;
+        for(auto& col : cols) {
+            uint32_t n = 0;
+            in.read(reinterpret_cast<char*>(&col.distinct), 8);
+            in.read(reinterpret_cast<char*>(&n), 4);
+            if(!in || n > HISTOGRAM_BUCKETS) return false;
+            col.bounds.resize(n);
+            for(auto& bound : col.bounds) {
+                uint32_t len = 0;
+                in.read(reinterpret_cast<char*>(&len), 4);
+                if(!in || len > Page::MAX_RECORD) return false;
+                bound.resize(len);
+                in.read(&bound[0], len);
+            }
+        }
+        return static_cast<bool>(in);
+    }
+
+private:
+    // 列 < 值 的比例: 上界小于值的桶全部计入, 值所在的桶计入一半
+    static double fractionBelow(const ColumnStats& col, const Condition& cond) {
+        if(col.bounds.empty()) return guess(cond);
+        size_t below = 0;
+        while(below < col.bounds.size() && boundLess(col.bounds[below], cond)) ++below;
+        return min(1.0, (below + 0.5) / col.bounds.size());
+    }
+
+    static bool boundLess(const string& bound, const Condition& cond) {
+        try {
+            if(cond.type == "INTEGER") return stoll(bound) < cond.intValue;
+            if(cond.type == "FLOAT") return parseFloat(bound) < cond.floatValue;
+            DecimalValue d;
+            if(columnKind(cond.type) == 'D') return parseDecimal(bound, decimalScale(cond.type), d) && d.rounded < cond.intValue;
+        } catch(...) {
+            return false;
+        }
+        return bound < cond.value;
+    }
+};
+
+//WHERE条件组的选择率: AND按独立相乘, OR按容斥; stats为空时用默认估计
+inline double estimateSelectivity(const ConditionSet& where, const TableStats* stats) {
+    if(where.empty()) return 1;
+    auto one = [&](const Condition& cond) { return stats ? stats->selectivity(cond) : TableStats::guess(cond); };
+    double first = one(where.conds[0]);
+    if(where.logicalOp.empty()) return first;
+    double second = where.conds.size() > 1 ? one(where.conds[1]) : 0;
+    if(where.logicalOp == "AND") return first * second;
+    if(where.logicalOp == "OR") return first + second - first * second;
+    return 1;
+}
+
+//代价单位约为"扫描一行"
+const double COST_PAIR = 0.02;    // 嵌套循环中比较一对行的连接列
+const double COST_BUILD = 2.0;    // 复制一行并插入哈希表
+const double COST_PROBE = 1.0;    // 探测一次哈希表
+const double COST_REORDER = 0.5;  // 建表侧为FROM中靠前的表时, 每个结果行为恢复输出顺序的排序代价
+
+//整数连接键换算到两边中较大的小数位数: INTEGER与DECIMAL(5,2)比较时1换成100; 乘法溢出的值绝对值超过10^18,
+//不可能等于另一边(小数位数更大的DECIMAL)的任何值, 换成int64最大值
+inline int64_t scaleKey(int64_t v, int64_t factor) {
+    int64_t out;
+    return __builtin_mul_overflow(v, factor, &out) ? numeric_limits<int64_t>::max() : out;
+}
+
+//Bloom过滤器: 每个键约10位, 3个位置由一个64位哈希派生; 存在的键一定返回true, 不存在的键少数误判为true
+class BloomFilter {
+public:
+    explicit BloomFilter(size_t keys = 0) {
+        size_t n = 64;
+        while(n < keys * BITS_PER_KEY) n <<= 1;
+        bits.assign(n / 64, 0);
+        mask = n - 1;
+    }
+
+    size_t bitCount() const { return bits.size() * 64; }
+
+    void add(uint64_t h) {
+        for(int i = 0; i < HASHES; ++i) {
+            size_t bit = position(h, i);
+            bits[bit / 64] |= 1ULL << (bit % 64);
+        }
+    }
+
+    bool mayContain(uint64_t h) const {
+        for(int i = 0; i < HASHES; ++i) {
+            size_t bit = position(h, i);
+            if(!(bits[bit / 64] >> (bit % 64) & 1)) return false;
+        }
+        return true;
+    }
+
+    // 连接列的哈希: 整数列按换算到共同小数位数后的值(factor见JoinKey), 文本列按内容; 两边相等的值哈希相同
+    static uint64_t hashKey(const RowStore& rows, size_t row, size_t col, bool intKey, int64_t factor = 1) {
+        uint64_t h = intKey ? static_cast<uint64_t>(scaleKey(rows.integer(row, col), factor)) : hash<string_view>()(rows.text(row, col));
+        // splitmix64的混合步骤, 让相邻的整数键也分散
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return h ^ (h >> 31);
+    }
+
+private:
+    static const size_t BITS_PER_KEY = 10;
+    static const int HASHES = 3;
+
+    size_t position(uint64_t h, int i) const {
+        return static_cast<size_t>((h + i * ((h >> 32) | 1)) & mask);
+    }
+
+    vector<uint64_t> bits;
+    size_t mask = 63;
+};
+
+const size_t BLOOM_SAMPLE_ROWS = 4096;  // Bloom过滤器先检查这么多行, 通过率太高时停止检查
+
+//ON中的一个等值条件; 表序号为表在FROM/INNER JOIN中出现的顺序
+struct JoinKey {
+    size_t left = 0, right = 0;  // 两边的表序号
+    size_t leftCol = TableSchema::npos, rightCol = TableSchema::npos;
+    bool intKey = false;   // 两边都是内联整数(INTEGER或DECIMAL), 换算到共同的小数位数后比较
+    bool textKey = false;  // 两边都不是内联整数, 比较文本; 都不成立时按字符串逐对比较
+    int64_t leftFactor = 1, rightFactor = 1;  // intKey时: 两边换算到较大的小数位数所乘的10^Δ
+    string text;           // ON的原文, EXPLAIN用
+
+    bool known() const { return leftCol != TableSchema::npos && rightCol != TableSchema::npos; }
+    bool hashable() const { return intKey || textKey; }
+    int64_t factor(size_t table) const { return table == left ? leftFactor : rightFactor; }
+
+    // l为left表中的行, r为right表中的行; 列不存在时不限制(与原来的行为一致)
+    bool equal(const RowStore& l, size_t i, const RowStore& r, size_t j) const {
+        if(intKey) return scaleKey(l.integer(i, leftCol), leftFactor) == scaleKey(r.integer(j, rightCol), rightFactor);
+        if(textKey) return l.text(i, leftCol) == r.text(j, rightCol);
+        return !known() || l.get(i, leftCol) == r.get(j, rightCol);
+    }
+};
+
+//连接的一步: 把一张表接到已经连接好的中间结果上
+struct JoinStep {
+    size_t table = 0;       // 新接入的表
+    vector<size_t> keys;    // 这一步检查的ON条件; 哈希连接时第一个是哈希键
+    bool hash = false;      // 哈希表建在新表上, 否则块嵌套循环(新表为内表)
+    bool reorder = false;   // 只用于第一步: 哈希表建在FROM中靠前的表上, 结果按它的行序排序后输出
+    double rowsIn = 0, rows = 0, rowsOut = 0;  // 估计的中间结果行数、新表(过滤下推后)行数、连接后行数
+    double cost = 0, nestedLoopCost = 0;
+};
+
+//解析后的INNER JOIN链: 连接列、输出列和WHERE条件都已定位为(表序号, 列序号)
+struct JoinSpec {
+    vector<string> tables;
+    vector<JoinKey> keys;
+    vector<pair<size_t,size_t>> projection;  // (表序号, 列序号)
+    vector<pair<size_t,Condition>> where;    // (表序号, 条件)
+    string andOr;
+    bool pushdown = false;  // WHERE只由AND连接(或只有一个条件), 等价于每张表各自的过滤prune[t]
+    vector<ConditionSet> prune;
+    vector<vector<size_t>> columns;  // 每张表在扫描之后用到的列(ON、输出列和WHERE), 连接只取这些列
+    vector<size_t> order;     // 连接顺序: order[0]是驱动表(探测侧/外表), steps[s]接入order[s+1]
+    vector<size_t> position;  // 表序号 -> 在中间结果的批中的位置
+    vector<JoinStep> steps;
+};
+
+using RowRef = pair<const RowStore*, size_t>;
+
+//在一个元组上检查ON条件spec.keys[keys[from..]]; locate(t)给出表t在元组中的行
+template<typename Locate>
+bool keysMatch(const JoinSpec& spec, const vector<size_t>& keys, size_t from, Locate locate) {
+    for(size_t i = from; i < keys.size(); ++i) {
+        const JoinKey& key = spec.keys[keys[i]];
+        RowRef l = locate(key.left), r = locate(key.right);
+        if(!key.equal(*l.first, l.second, *r.first, r.second)) return false;
+    }
+    return true;
+}
+
+//********** EXPLAIN / EXPLAIN ANALYZE **********
+//查询计划中的一个算子; ANALYZE时记录实际的输入/输出行数、调用次数和自身耗时(不含子算子)
+struct PlanNode {
+    string op;
+    string detail;  // 访问路径、连接算法、谓词等
+    int depth = 0;  // 在计划树中的深度, 输出时缩进
+    bool hasRowsIn = true;  // 扫描是叶子算子, 没有输入行数
+    size_t rowsIn = 0, rowsOut = 0, loops = 0;
+    double ms = 0;
+};
+
+struct QueryPlan {
+    bool analyze = false;
+    vector<PlanNode> nodes;
+};
+
+//算子之间传递的一批元组, 每个元组由tables中每个表各一行组成
+//扫描推出的稠密批只有一个表, 行号为[begin, begin+count), 不存行号列表
+struct Batch {
+    vector<const RowStore*> tables;
+    vector<vector<size_t>> rows;  // rows[t][k]: 第k个元组在tables[t]中的行号
+    size_t begin = 0;
+    size_t count = 0;
+    bool stable = false;  // tables在整个查询期间有效(内存表), 下游只记行号即可, 不必复制行
+    string text;  // 投影后的CSV行
+
+    size_t row(size_t t, size_t k) const { return rows.empty() ? begin + k : rows[t][k]; }
+
+    // 换成新的表, 清空行号列表但保留容量
+    void reset(const vector<const RowStore*>& from, bool isStable = false) {
+        tables = from;
+        rows.resize(from.size());
+        for(auto& ids : rows) ids.clear();
+        count = 0;
+        stable = isStable;
+    }
+};
+
+//ANALYZE计时; 不是EXPLAIN ANALYZE时不读时钟
+inline double planClock(const QueryPlan* plan) {
+    if(!plan || !plan->analyze) return 0;
+    return chrono::duration<double, milli>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//PRIMARY KEY / UNIQUE约束和它的哈希索引: 规范化的值 -> 行位置(内存表为行号, 页存储表为 页号<<16 | 槽号)
+//索引在第一次用到时扫描全表建立; 删除行或把页存储表读入内存会移动行, 之后重建
+struct UniqueIndex {
+    size_t col;
+    bool primary;
+    bool built = false;
+    unordered_map<string, uint64_t> rows;
+
+    UniqueIndex(size_t col, bool primary) : col(col), primary(primary) {}
+    const char* label() const { return primary ? "PRIMARY KEY" : "UNIQUE"; }
+};
+
+//索引键: 与WHERE的比较方式一致, INTEGER、FLOAT和DECIMAL按数值规范化(1.50和1.5是同一个值), TEXT按原文
+inline string floatKey(float v) {
+    if(v == 0) v = 0;  // -0与0相等
+    char buffer[32];
+    auto written = to_chars(buffer, buffer + sizeof(buffer), v);
+    return string(buffer, written.ptr);
+}
+
+inline string indexKey(const string& type, string_view value) {
+    if(type == "INTEGER") {
+        int64_t v;
+        return RowStore::parseInteger(string(value), v) ? to_string(v) : string(value);
+    }
+    if(type == "FLOAT") return floatKey(parseFloat(value));
+    DecimalValue d;
+    if(columnKind(type) == 'D') return parseDecimal(value, decimalScale(type), d) ? to_string(d.rounded) : string(value);
+    return string(value);
+}
+
+inline string conditionKey(const Condition& cond) {
+    if(integralType(cond.type)) return to_string(cond.intValue);
+    if(cond.type == "FLOAT") return floatKey(cond.floatValue);
+    return cond.value;
+}
+
+//表分区: 按分区列的值把行分到几张子表(表名#序号), 每个分区有自己的行存储、页文件和块统计
+//HASH按规范化后的值的哈希取模; RANGE按上界划分, 第k个分区存放[bounds[k-1], bounds[k])中的值, 两端的分区不设界
+struct PartitionSpec {
+    bool range = false;
+    size_t col = 0;
+    string type;            // 分区列的类型, RANGE只支持INTEGER和FLOAT
+    size_t count = 0;       // 分区数
+    vector<string> bounds;  // RANGE: 递增的上界, 共count-1个
+
+    static string partName(const string& tableName, size_t k) { return tableName + "#" + to_string(k); }
+
+    // 值(表中的写法)所在的分区
+    size_t partitionOf(string_view value) const {
+        if(!range) {
+            // FNV-1a: 分区号随数据持久化, 不能用随实现变化的std::hash
+            uint64_t h = 14695981039346656037ULL;
+            for(unsigned char c : indexKey(type, value)) h = (h ^ c) * 1099511628211ULL;
+            return static_cast<size_t>(h % count);
+        }
+        size_t k = 0;
+        while(k < bounds.size() && !below(value, bounds[k])) ++k;
+        return k;
+    }
+
+    // 第k个分区是否可能有行满足条件; 与块统计一样只排除确定不可能的分区
+    bool mayMatch(size_t k, const Condition& cond) const {
+        if(cond.index != col || cond.cmp == CmpOp::OTHER) return true;
+        if(cond.cmp == CmpOp::EQ) return partitionOf(cond.value) == k;
+        if(!range) return true;
+        if(type == "INTEGER") {
+            int64_t lo = numeric_limits<int64_t>::min(), hi = numeric_limits<int64_t>::max();
+            if(k > 0) RowStore::parseInteger(bounds[k - 1], lo);
+            if(k < bounds.size()) RowStore::parseInteger(bounds[k], hi);
+            return rangeMayMatch(lo, hi, cond.intValue, cond.cmp);
+        }
+        float lo = k > 0 ? parseFloat(bounds[k - 1]) : -numeric_limits<float>::infinity();
+        float hi = k < bounds.size() ? parseFloat(bounds[k]) : numeric_limits<float>::infinity();
+        return rangeMayMatch(lo, hi, cond.floatValue, cond.cmp);
+    }
+
+    bool mayMatch(size_t k, const ConditionSet& where) const {
+        if(where.empty()) return true;
+        bool first = mayMatch(k, where.conds[0]);
+        if(where.logicalOp.empty()) return first;
+        bool second = where.conds.size() > 1 && mayMatch(k, where.conds[1]);
+        if(where.logicalOp == "AND") return first && second;
+        if(where.logicalOp == "OR") return first || second;
+        return true;
+    }
+
+    // RANGE: value < bound, 按列类型比较数值
+    bool below(string_view value, const string& bound) const {
+        if(type == "INTEGER") {
+            int64_t v = 0, b = 0;
+            RowStore::parseInteger(string(value), v);
+            RowStore::parseInteger(bound, b);
+            return v < b;
+        }
+        return parseFloat(value) < parseFloat(bound);
+    }
+};
+
+class Database {
+public:
+    string name;
+    unordered_map<string, shared_ptr<RowStore>> tables;  // 存储表的数据; 并行执行时读语句持有旧版本的引用, 写语句写时复制
+    unordered_map<string, vector<Column>> tableColumns;  // 存储表的列信息
+    unordered_map<string, TableSchema> schemas;  // 列名->序号映射和类型, 与tableColumns同步维护
+    unordered_set<string> pagedTables;  // 数据仍在页文件中、未读入内存的表(tables中没有行)
+
+    Database() = default;
+    Database(const string& dbName) : name(dbName) {}
+
+    void setColumns(const string& tableName, const vector<Column>& columns) {
+        tableColumns[tableName] = columns;
+        schemas[tableName] = TableSchema(columns);
+    }
+
+    void dropColumns(const string& tableName) {
+        tableColumns.erase(tableName);
+        schemas.erase(tableName);
+    }
+
+    const TableSchema& schema(const string& tableName) const {
+        return schemas.at(tableName);
+    }
+
+    unordered_map<string, vector<Zone>> pageZones;  // 页存储表每页一个块统计, 与页文件一起持久化
+
+    string pageFile(const string& tableName) const {
+        return name + "." + tableName + ".tbl";
+    }
+
+    string zoneFile(const string& tableName) const {
+        return name + "." + tableName + ".zm";
+    }
+
+    string overflowFile(const string& tableName) const {
+        return name + "." + tableName + ".ov";
+    }
+
+    unordered_map<string, TableStats> tableStats;  // ANALYZE收集的统计, 不随数据修改自动更新
+
+    string statsFile(const string& tableName) const {
+        return name + "." + tableName + ".st";
+    }
+
+    unordered_map<string, uint64_t> tableVersions;  // 表每次被修改(或重新载入)时取一个新版本号, 结果缓存据此判断是否过期
+
+    unordered_map<string, vector<UniqueIndex>> uniqueIndexes;  // 每张表的PRIMARY KEY/UNIQUE列, 约束随目录持久化
+    unordered_map<string, PartitionSpec> partitions;  // 分区表的分区方式; 表本身没有行, 行在各分区的子表中
+
+    static bool isPartition(const string& tableName) { return tableName.find('#') != string::npos; }
+
+    uint64_t version(const string& tableName) const {
+        auto it = tableVersions.find(tableName);
+        return it == tableVersions.end() ? 0 : it->second;
+    }
+};
+
+//规范化SQL作为缓存键: 引号外的连续空白合并为一个空格, 去掉首尾空白
+inline string normalizeSql(const string& sql)
+{
+    string out;
+    bool inQuotes = false, space = false;
+    for(char c : sql) {
+        if(c == '\'') inQuotes = !inQuotes;
+        if(!inQuotes && isspace(static_cast<unsigned char>(c))) {
+            space = !out.empty();
+            continue;
+        }
+        if(space) out += ' ';
+        space = false;
+        out += c;
+    }
+    return out;
+}
+
+//查询结果缓存: 键为(数据库, 规范化SQL), 值为列名行和结果行的文本, 连同生成结果时各表的版本号
+//表版本号变了的条目在查找时作废; 总大小超过capacity字节时按LRU淘汰, capacity为0时不缓存
+class ResultCache {
+public:
+    explicit ResultCache(size_t capacity = 64 << 20) : capacity(capacity) {}
+
+    uint64_t hits = 0, misses = 0, evictions = 0, invalidations = 0;
+
+    // 正在执行的查询把输出同时写到这里, 执行完整结束时complete为true
+    struct Capture {
+        string text;
+        size_t rows = 0;
+        bool complete = false;
+    };
+
+    struct Entry {
+        string key;
+        vector<uint64_t> versions;
+        string text;
+        size_t rows = 0;
+
+        size_t bytes() const { return key.size() + text.size() + versions.size() * sizeof(uint64_t) + sizeof(Entry); }
+    };
+
+    bool enabled() const { return capacity > 0; }
+
+    void setCapacity(size_t bytes) {
+        lock_guard<mutex> lock(latch);
+        capacity = bytes;
+        shrink(capacity);
+    }
+
+    // 命中时把条目复制到found: 并行执行的其他语句随时可能把它淘汰
+    bool find(const string& key, const vector<uint64_t>& versions, Entry& found) {
+        lock_guard<mutex> lock(latch);
+        auto it = index.find(key);
+        if(it == index.end()) {
+            misses++;
+            return false;
+        }
+        if(it->second->versions != versions) {
+            invalidations++;
+            misses++;
+            erase(it->second);
+            return false;
+        }
+        hits++;
+        entries.splice(entries.begin(), entries, it->second);
+        found = entries.front();
+        return true;
+    }
+
+    // 超过容量1/8的结果不缓存, 免得一条大结果把其它条目全部挤掉
+    void put(Entry entry) {
+        lock_guard<mutex> lock(latch);
+        size_t bytes = entry.bytes();
+        if(!enabled() || bytes > capacity / 8) return;
+        auto it = index.find(entry.key);
+        if(it != index.end()) erase(it->second);
+        shrink(capacity - bytes);
+        entries.push_front(move(entry));
+        index[entries.front().key] = entries.begin();
+        used += bytes;
+    }
+
+    void writeSummary(ostream& out) const {
+        uint64_t lookups = hits + misses;
+        out << "result cache: " << hits << " hits, " << misses << " misses";
+        if(lookups) out << " (" << fixed << setprecision(1) << 100.0 * hits / lookups << "% hit rate)";
+        out << ", " << invalidations << " invalidated, " << evictions << " evicted, "
+            << entries.size() << " entries, " << used << " of " << capacity << " bytes" << endl;
+    }
+
+private:
+    size_t capacity;
+    size_t used = 0;
+    mutex latch;
+    list<Entry> entries;  // 最近使用的在前
+    unordered_map<string, list<Entry>::iterator> index;
+
+    void erase(list<Entry>::iterator it) {
+        used -= it->bytes();
+        index.erase(it->key);
+        entries.erase(it);
+    }
+
+    void shrink(size_t limit) {
+        while(used > limit && !entries.empty()) {
+            erase(prev(entries.end()));
+            evictions++;
+        }
+    }
+};
+
+//一条单表SELECT解析后的各部分, 共享扫描时攒在一起执行
+struct SelectQuery {
+    string sql;  // 原语句, 用作结果缓存的键
+    int line = 0;
+    string table;
+    vector<string> columns, conditions;
+};
+
+class MiniDB {
+public:
+
+    unordered_map<string, Database> databases;
+    Database* currentDatabase = nullptr;
+    static inline thread_local bool isprint=false;  // 每个线程一份: 并行执行时各语句先写自己的缓冲, 提交时再加分隔行
+    BufferPool bufferPool;  // 页存储表的缓冲池
+    Profiler profiler{bufferPool};  // --profile时记录每条语句的阶段耗时
+    ResultCache resultCache;  // SELECT/INNER JOIN的结果缓存
+    MemoryTracker memory;  // 表的行存储和查询工作内存的记账与上限
+    static inline thread_local ResultCache::Capture* capture = nullptr;  // 非空时当前线程的查询输出同时写入这里
+    static inline thread_local stringbuf* outputBuffer = nullptr;  // 非空时当前线程的查询结果写到这里而不是结果文件
+
+    // 库接口取查询结果: 输出列的列名、类型和按类型保存的行
+    struct ResultSet {
+        vector<string> names, types;
+        RowStore rows;
+    };
+    static inline thread_local ResultSet* collect = nullptr;  // 非空时当前线程的SELECT把结果行收集到这里, 不写结果文件
+    atomic<uint64_t> versionClock{0};  // 表版本号的来源, 单调递增
+    atomic<bool> deferSave{false};     // 并行执行一段语句期间不写回数据库, 只记下需要写回
+    atomic<bool> savePending{false};
+    size_t scanThreads = 1;         // 分区表扫描时同时读分区的线程数
+    atomic<size_t> scanSlots{0};    // 缓冲池中留给分区读线程的页数: 每个读线程同时钉住一页
+
+    // 读语句看到的一张表: 固定下来的行存储版本和它的版本号
+    struct TableSnapshot {
+        shared_ptr<const RowStore> rows;
+        uint64_t version = 0;
+    };
+    using Snapshot = unordered_map<string, TableSnapshot>;
+    static inline thread_local const Snapshot* snapshot = nullptr;  // 非空时当前线程的读语句只读这里的版本
+    mutex snapshotLatch;  // 保护并行执行时表的当前版本(tables中的指针)和版本号
+
+//表的内容或结构变了: 取一个新版本号, 缓存中用到这张表的结果随之作废
+void touchTable(const string& tableName)
+{
+    lock_guard<mutex> lock(snapshotLatch);
+    currentDatabase->tableVersions[tableName] = ++versionClock;
+    chargeTable(tableName);
+}
+
+//重新登记一张表的行存储占用的内存; 页存储的表没有读入内存的行, 已删除的表撤销登记
+void chargeTable(const string& tableName)
+{
+    auto it = currentDatabase->tables.find(tableName);
+    size_t bytes = it == currentDatabase->tables.end() || !it->second ? 0 : it->second->memoryBytes();
+    memory.chargeTable(currentDatabase->name + "." + tableName, bytes);
+}
+
+//固定表的当前版本, 调用方持有snapshotLatch
+TableSnapshot takeSnapshot(const string& tableName)
+{
+    return {currentDatabase->tables.at(tableName), currentDatabase->version(tableName)};
+}
+
+//读语句看到的表: 当前线程有快照时读快照中的版本, 否则读当前的表
+const RowStore& readTable(const string& tableName)
+{
+    if(snapshot) {
+        auto it = snapshot->find(tableName);
+        if(it != snapshot->end()) return *it->second.rows;
+    }
+    static const RowStore none;
+    auto it = currentDatabase->tables.find(tableName);
+    return it == currentDatabase->tables.end() ? none : *it->second;
+}
+
+uint64_t tableVersion(const string& tableName)
+{
+    if(snapshot) {
+        auto it = snapshot->find(tableName);
+        if(it != snapshot->end()) return it->second.version;
+    }
+    lock_guard<mutex> lock(snapshotLatch);
+    return currentDatabase->version(tableName);
+}
+
+//按块扫描表: 内存中的表按BLOCK_ROWS行分块; 页存储的表逐页钉住、解码后释放, 连续的页攒够BLOCK_ROWS行再交给回调
+//给出where时先查块统计, 不可能有行满足条件的块(页)直接跳过, 不读不解码; blocksRead累加实际读取的块(页)数
+//给出columns时页存储的表只解码选中的列, 其余列为0或空串
+template<typename Fn>
+void scanTable(const string& tableName, Fn onBlock, const ConditionSet* where = nullptr, size_t* blocksRead = nullptr, const vector<bool>* columns = nullptr)
+{
+    vector<const ConditionSet*> wheres;
+    if(where) wheres.push_back(where);
+    scanTableShared(tableName, [&](const RowStore& rows, size_t begin, size_t end, const vector<bool>&) {
+        onBlock(rows, begin, end);
+    }, wheres, blocksRead, columns);
+}
+
+//分区表中可能有行满足某条查询WHERE的分区; wheres为空时为全部分区
+vector<string> prunePartitions(const string& tableName, const vector<const ConditionSet*>& wheres)
+{
+    const PartitionSpec& spec = currentDatabase->partitions.at(tableName);
+    vector<string> parts;
+    for(size_t k = 0; k < spec.count; ++k) {
+        bool any = wheres.empty();
+        for(const ConditionSet* where : wheres) any = any || spec.mayMatch(k, *where);
+        if(any) parts.push_back(PartitionSpec::partName(tableName, k));
+    }
+    return parts;
+}
+
+//共享扫描: 同一遍扫描服务多条查询, 只有每条查询的WHERE都被块统计排除的块才跳过; wheres为空时不跳过
+//回调多一个参数wanted: wanted[i]为false时块中不可能有行满足第i条查询的WHERE, 这条查询可以不看这一块
+//页存储的表只把wanted相同的连续页攒成一批
+//分区表依次扫描没有被WHERE排除的分区; 页存储的分区有多个时由读线程并行读取
+template<typename Fn>
+void scanTableShared(const string& tableName, Fn onBlock, const vector<const ConditionSet*>& wheres, size_t* blocksRead = nullptr, const vector<bool>* columns = nullptr)
+{
+    if(currentDatabase->partitions.count(tableName)) {
+        vector<string> parts = prunePartitions(tableName, wheres);
+        bool paged = all_of(parts.begin(), parts.end(), [&](const string& part) { return currentDatabase->pagedTables.count(part) > 0; });
+        size_t workers = paged ? reserveScanSlots(min(scanThreads, parts.size())) : 0;
+        if(workers > 1) {
+            PartitionPrefetch prefetch;
+            prefetch.parts = move(parts);
+            startPrefetch(prefetch, workers, wheres, columns);
+            try {
+                pair<RowStore, vector<bool>> block;
+                for(size_t k = 0; k < prefetch.parts.size(); ++k) {
+                    while(nextPrefetched(prefetch, k, block)) onBlock(block.first, 0, block.first.size(), block.second);
+                    if(blocksRead) *blocksRead += prefetch.queues[k].pages;
+                }
+            } catch(...) {
+                stopPrefetch(prefetch);
+                throw;
+            }
+            stopPrefetch(prefetch);
+            if(prefetch.failure) rethrow_exception(prefetch.failure);
+        } else {
+            scanSlots += workers;
+            for(const auto& part : parts) scanStorage(part, onBlock, wheres, blocksRead, columns);
+        }
+        return;
+    }
+    scanStorage(tableName, onBlock, wheres, blocksRead, columns);
+}
+
+//扫描一张表(或一个分区)自己的存储
+template<typename Fn>
+void scanStorage(const string& tableName, Fn onBlock, const vector<const ConditionSet*>& wheres, size_t* blocksRead, const vector<bool>* columns)
+{
+    vector<bool> wanted, mask(wheres.size());
+    // 按一块(页)的统计判断各条查询是否要看它, 结果写入mask; 返回是否有查询要看
+    auto check = [&](const Zone* zone) {
+        bool any = wheres.empty();
+        for(size_t i = 0; i < wheres.size(); ++i) {
+            mask[i] = !zone || zone->mayMatch(*wheres[i]);
+            any = any || mask[i];
+        }
+        return any;
+    };
+    const auto& table = readTable(tableName);
+    if(currentDatabase->pagedTables.find(tableName) == currentDatabase->pagedTables.end()) {
+        const auto& zones = table.zones();
+        for(size_t begin = 0, k = 0; begin < table.size(); begin += BLOCK_ROWS, ++k) {
+            if(!check(k < zones.size() ? &zones[k] : nullptr)) continue;
+            size_t end = min(table.size(), begin + BLOCK_ROWS);
+            profiler.addScanned(end - begin);
+            if(blocksRead) ++*blocksRead;
+            onBlock(table, begin, end, mask);
+        }
+        return;
+    }
+    string pageFile = currentDatabase->pageFile(tableName);
+    size_t pages = bufferPool.pageCount(pageFile);
+    auto zoneEntry = currentDatabase->pageZones.find(tableName);  // 只查不插入: 并行执行时别的线程可能同时在读这张映射表
+    static const vector<Zone> noZones;
+    const auto& zones = zoneEntry == currentDatabase->pageZones.end() ? noZones : zoneEntry->second;
+    bool useZones = !wheres.empty() && zones.size() == pages;
+    RowStore block(currentDatabase->schema(tableName).types, false);
+    vector<string_view> fields;
+    OverflowReader overflow(currentDatabase->overflowFile(tableName));
+    auto deliver = [&] {
+        if(block.size() == 0) return;
+        profiler.addScanned(block.size());
+        onBlock(block, 0, block.size(), wanted);
+        block.clear();
+    };
+    for(size_t p = 0; p < pages; ++p) {
+        if(!check(useZones ? &zones[p] : nullptr)) continue;
+        if(mask != wanted) {
+            deliver();
+            wanted = mask;
+        }
+        {
+            ProfileScope scope(profiler, Phase::SCAN);
+            Page* page = bufferPool.pin(pageFile, p);
+            for(size_t s = 0; s < page->slotCount(); ++s) {
+                if(columns) {
+                    page->fields(s, fields, overflow);
+                    block.appendColumns(fields, *columns);
+                } else {
+                    block.append(page->row(s, overflow));
+                }
+            }
+            bufferPool.unpin(pageFile, p, false);
+        }
+        if(blocksRead) ++*blocksRead;
+        if(block.size() >= BLOCK_ROWS) deliver();
+    }
+    deliver();
+}
+
+//从scanSlots中取至多wanted个读线程的名额, 返回取到的个数
+size_t reserveScanSlots(size_t wanted)
+{
+    size_t free = scanSlots.load();
+    size_t taken;
+    do {
+        taken = min(wanted, free);
+    } while(taken > 0 && !scanSlots.compare_exchange_weak(free, free - taken));
+    return taken;
+}
+
+//并行读页存储的分区: 读线程按分区顺序各取一个分区, 逐页解码成块放入该分区的队列, 每个分区最多预读PARTITION_PREFETCH块
+//调用线程按分区顺序取块, 结果顺序与逐个分区扫描相同; 下游得到的是块的副本, 不会随扫描继续而改变
+struct PartitionPrefetch {
+    struct Queue {
+        deque<pair<RowStore, vector<bool>>> blocks;  // 解码好的块和它的wanted
+        size_t pages = 0;
+        bool done = false;
+    };
+    vector<string> parts;
+    vector<Queue> queues;
+    mutex latch;
+    condition_variable changed;
+    atomic<size_t> next{0};
+    bool stopped = false;  // 调用线程提前结束(出错), 读线程丢弃后面的块
+    exception_ptr failure;
+    vector<thread> readers;
+};
+
+void startPrefetch(PartitionPrefetch& prefetch, size_t workers, const vector<const ConditionSet*>& wheres, const vector<bool>* columns)
+{
+    prefetch.queues = vector<PartitionPrefetch::Queue>(prefetch.parts.size());
+    for(size_t w = 0; w < workers; ++w) {
+        prefetch.readers.emplace_back([this, &prefetch, &wheres, columns] {
+            for(size_t k; (k = prefetch.next++) < prefetch.parts.size();) {
+                auto& queue = prefetch.queues[k];
+                size_t pages = 0;
+                try {
+                    scanStorage(prefetch.parts[k], [&](const RowStore& rows, size_t, size_t, const vector<bool>& wanted) {
+                        unique_lock<mutex> lock(prefetch.latch);
+                        prefetch.changed.wait(lock, [&] { return prefetch.stopped || queue.blocks.size() < PARTITION_PREFETCH; });
+                        if(!prefetch.stopped) queue.blocks.emplace_back(rows, wanted);
+                        prefetch.changed.notify_all();
+                    }, wheres, &pages, columns);
+                } catch(...) {
+                    lock_guard<mutex> lock(prefetch.latch);
+                    if(!prefetch.failure) prefetch.failure = current_exception();
+                }
+                lock_guard<mutex> lock(prefetch.latch);
+                queue.pages = pages;
+                queue.done = true;
+                prefetch.changed.notify_all();
+            }
+        });
+    }
+}
+
+//取第k个分区的下一块; 这个分区读完时返回false
+bool nextPrefetched(PartitionPrefetch& prefetch, size_t k, pair<RowStore, vector<bool>>& block)
+{
+    unique_lock<mutex> lock(prefetch.latch);
+    auto& queue = prefetch.queues[k];
+    prefetch.changed.wait(lock, [&] { return !queue.blocks.empty() || queue.done; });
+    if(queue.blocks.empty()) return false;
+    block = move(queue.blocks.front());
+    queue.blocks.pop_front();
+    prefetch.changed.notify_all();
+    return true;
+}
+
+void stopPrefetch(PartitionPrefetch& prefetch)
+{
+    {
+        lock_guard<mutex> lock(prefetch.latch);
+        prefetch.stopped = true;
+        prefetch.changed.notify_all();
+    }
+    for(auto& reader : prefetch.readers) reader.join();
+    scanSlots += prefetch.readers.size();
+    prefetch.readers.clear();
+}
+
+//唯一索引还没建立(或行已移动)时扫描全表建立; 已有数据中的重复值只记第一次出现的行
+UniqueIndex& ensureIndex(const string& tableName, UniqueIndex& index)
+{
+    if(index.built) {
+        return index;
+    }
+    ProfileScope scope(profiler, Phase::LOAD);
+    index.rows.clear();
+    const string& type = currentDatabase->schema(tableName).types[index.col];
+    if(currentDatabase->pagedTables.count(tableName)) {
+        string pageFile = currentDatabase->pageFile(tableName);
+        size_t pages = bufferPool.pageCount(pageFile);
+        vector<string_view> fields;
+        OverflowReader overflow(currentDatabase->overflowFile(tableName));
+        for(size_t p = 0; p < pages; ++p) {
+            Page* page = bufferPool.pin(pageFile, p);
+            for(size_t slot = 0; slot < page->slotCount(); ++slot) {
+                page->fields(slot, fields, overflow);
+                if(index.col < fields.size()) index.rows.emplace(indexKey(type, fields[index.col]), (p << 16) | slot);
+            }
+            bufferPool.unpin(pageFile, p, false);
+        }
+    } else {
+        const RowStore& table = *currentDatabase->tables[tableName];
+        for(size_t r = 0; r < table.size(); ++r) {
+            index.rows.emplace(table.isInteger(index.col) ? to_string(table.integer(r, index.col)) : indexKey(type, table.text(r, index.col)), r);
+        }
+    }
+    index.built = true;
+    return index;
+}
+
+//行被移动(删除、读入内存)后索引中的位置失效, 下次用到时重建
+void invalidateIndexes(const string& tableName)
+{
+    auto it = currentDatabase->uniqueIndexes.find(tableName);
+    if(it == currentDatabase->uniqueIndexes.end()) return;
+    for(auto& index : it->second) {
+        index.built = false;
+        index.rows.clear();
+    }
+}
+
+//WHERE只有唯一索引列上的一个等值条件时返回该索引, 按值直接找到至多一行
+//并行执行的读语句读的是快照, 索引反映的是最新的表, 不用索引
+UniqueIndex* lookupIndex(const string& tableName, const ConditionSet* where)
+{
+    if(snapshot || !where || where->conds.size() != 1 || where->conds[0].cmp != CmpOp::EQ) {
+        return nullptr;
+    }
+    auto it = currentDatabase->uniqueIndexes.find(tableName);
+    if(it == currentDatabase->uniqueIndexes.end()) return nullptr;
+    for(auto& index : it->second) {
+        if(index.col == where->conds[0].index) return &index;
+    }
+    return nullptr;
+}
+
+//按唯一索引读一行: 找到时以只含这一行的块调用onBlock; 页存储的表把这一行(columns中的列)解码到临时块
+template<typename Fn>
+void lookupRow(const string& tableName, UniqueIndex& index, const Condition& cond, Fn onBlock, size_t* blocksRead = nullptr, const vector<bool>* columns = nullptr)
+{
+    ensureIndex(tableName, index);
+    auto it = index.rows.find(conditionKey(cond));
+    if(it == index.rows.end()) {
+        return;
+    }
+    if(blocksRead) ++*blocksRead;
+    if(!currentDatabase->pagedTables.count(tableName)) {
+        onBlock(*currentDatabase->tables[tableName], it->second, it->second + 1);
+        return;
+    }
+    const auto& types = currentDatabase->schema(tableName).types;
+    string pageFile = currentDatabase->pageFile(tableName);
+    size_t pageNo = it->second >> 16, slot = it->second & 0xFFFF;
+    RowStore block(types, false);
+    vector<string_view> fields;
+    OverflowReader overflow(currentDatabase->overflowFile(tableName));
+    Page* page = bufferPool.pin(pageFile, pageNo);
+    page->fields(slot, fields, overflow);
+    block.appendColumns(fields, columns ? *columns : vector<bool>(types.size(), true));
+    bufferPool.unpin(pageFile, pageNo, false);
+    onBlock(block, 0, 1);
+}
+
+//把页存储的表整体读入内存(UPDATE/DELETE需要)
+void materialize(const string& tableName)
+{
+    if(currentDatabase->pagedTables.find(tableName) == currentDatabase->pagedTables.end()) {
+        return;
+    }
+    invalidateIndexes(tableName);
+    ProfileScope scope(profiler, Phase::LOAD);
+    auto& table = *currentDatabase->tables[tableName];
+    string pageFile = currentDatabase->pageFile(tableName);
+    size_t pages = bufferPool.pageCount(pageFile);
+    OverflowReader overflow(currentDatabase->overflowFile(tableName));
+    for(size_t p = 0; p < pages; ++p) {
+        Page* page = bufferPool.pin(pageFile, p);
+        for(size_t s = 0; s < page->slotCount(); ++s) {
+            table.append(page->row(s, overflow));
+        }
+        bufferPool.unpin(pageFile, p, false);
+    }
+    currentDatabase->pagedTables.erase(tableName);
+    currentDatabase->pageZones.erase(tableName);
+    bufferPool.discard(pageFile);
+}
+
+//把长值追加到溢出文件(第一次用到时打开), 返回它的偏移
+uint64_t appendOverflow(ofstream& out, const string& overflowFile, string_view value)
+{
+    if(!out.is_open()) {
+        out.open(overflowFile, ios::binary | ios::app);
+        if(!out.is_open()) throw runtime_error("Unable to open overflow file: " + overflowFile);
+        out.seekp(0, ios::end);
+    }
+    uint64_t at = static_cast<uint64_t>(out.tellp());
+    out.write(value.data(), static_cast<streamsize>(value.size()));
+    profiler.addWritten(value.size());
+    return at;
+}
+
+//向页存储的表追加一行: 写入最后一页, 放不下时追加新页; 返回新行的位置(页号<<16 | 槽号)
+template<typename Row>
+uint64_t appendToPages(const string& tableName, const Row& row)
+{
+    string pageFile = currentDatabase->pageFile(tableName);
+    ofstream overflow;
+    pmr::string record = Page::encodeRow(row, pmr::string(StatementArena::get()), [&](string_view value) {
+        return appendOverflow(overflow, currentDatabase->overflowFile(tableName), value);
+    });
+    size_t pages = bufferPool.pageCount(pageFile);
+    auto& zones = currentDatabase->pageZones[tableName];
+    bool trackZones = zones.size() == pages;
+    if(!trackZones) zones.clear();  // 统计已不完整, 不再使用
+    size_t pageNo = pages;
+    bool ok = false;
+    size_t slot = 0;
+    if(pages > 0) {
+        Page* page = bufferPool.pin(pageFile, pages - 1);
+        ok = page->insert(record);
+        slot = page->slotCount() - 1;
+        bufferPool.unpin(pageFile, pages - 1, ok);
+        pageNo = pages - 1;
+    }
+    if(!ok) {
+        Page* page = bufferPool.newPage(pageFile, pageNo);
+        page->insert(record);
+        slot = 0;
+        bufferPool.unpin(pageFile, pageNo, true);
+    }
+    // 维护所在页的块统计
+    if(trackZones) {
+        const auto& schema = currentDatabase->schema(tableName);
+        if(pageNo == zones.size()) zones.emplace_back(schema.size());
+        Zone& zone = zones[pageNo];
+        zone.rows++;
+        for(size_t c = 0; c < row.size() && c < schema.size(); ++c) {
+            zone.includeValue(c, columnKind(schema.types[c]), row[c], decimalScale(schema.types[c]));
+        }
+    }
+    return (static_cast<uint64_t>(pageNo) << 16) | slot;
+}
+
+//把内存中的表整体重写为页文件, 同时为每页生成块统计; 页外的长值一起重写到新的溢出文件
+void writePageFile(const string& pageFile, const string& zoneFile, const string& overflowFile, const RowStore& table)
+{
+    bufferPool.discard(pageFile);
+    ofstream out(pageFile, ios::binary | ios::trunc);
+    remove(overflowFile.c_str());
+    ofstream overflow;
+    vector<Zone> zones;
+    Page page;
+    page.init();
+    Zone zone(table.columnCount());
+    for(size_t i = 0; i < table.size(); ++i) {
+        string record = Page::encodeRow(table.row(i), string(), [&](string_view value) { return appendOverflow(overflow, overflowFile, value); });
+        if(!page.insert(record)) {
+            out.write(page.data, PAGE_SIZE);
+            profiler.addWritten(PAGE_SIZE);
+            zones.push_back(zone);
+            page.init();
+            page.insert(record);
+            zone = Zone(table.columnCount());
+        }
+        zone.rows++;
+        table.includeRow(zone, i);
+    }
+    if(page.slotCount() > 0) {
+        out.write(page.data, PAGE_SIZE);
+        profiler.addWritten(PAGE_SIZE);
+        zones.push_back(zone);
+    }
+    writeZoneFile(zoneFile, zones);
+}
+
+//块统计文件: [块数 u32] 之后依次为每个块
+void writeZoneFile(const string& zoneFile, const vector<Zone>& zones)
+{
+    ofstream out(zoneFile, ios::binary | ios::trunc);
+    uint32_t n = static_cast<uint32_t>(zones.size());
+    out.write(reinterpret_cast<const char*>(&n), 4);
+    for(const auto& zone : zones) {
+        zone.write(out);
+    }
+    profiler.addWritten(static_cast<uint64_t>(out.tellp()));
+}
+
+vector<Zone> readZoneFile(const string& zoneFile, size_t columnCount)
+{
+    vector<Zone> zones;
+    ifstream in(zoneFile, ios::binary);
+    uint32_t n = 0;
+    if(!in.read(reinterpret_cast<char*>(&n), 4)) return zones;
+    for(uint32_t i = 0; i < n; ++i) {
+        Zone zone(columnCount);
+        if(!zone.read(in)) return {};
+        zones.push_back(zone);
+    }
+    profiler.addRead(static_cast<uint64_t>(in.tellg()));
+    return zones;
+}
+
+//EXPLAIN: 表的访问路径和估计行数; WHERE是PRIMARY KEY/UNIQUE列上的=时走索引查找(估计1行),
+//否则全表扫描(内存表按块, 页存储表经缓冲池逐页, 分区表只扫描WHERE排除不了的分区)
+string describeScan(const string& tableName, const ConditionSet* where)
+{
+    ostringstream estimate;
+    double rows = estimateRows(tableName);
+    if(UniqueIndex* index = lookupIndex(tableName, where)) {
+        estimate << fixed << setprecision(0) << ", est. 1 of " << rows << " rows";
+        return "index lookup on " + currentDatabase->schema(tableName).columns[index->col].name + " (" + index->label() + ")" + estimate.str();
+    }
+    estimate << fixed << setprecision(0) << ", est. " << rows * (where ? estimateSelectivity(*where, statsFor(tableName)) : 1) << " of " << rows << " rows";
+    string detail = "full scan";
+    auto partitioned = currentDatabase->partitions.find(tableName);
+    if(partitioned != currentDatabase->partitions.end()) {
+        const PartitionSpec& spec = partitioned->second;
+        vector<const ConditionSet*> wheres;
+        if(where) wheres.push_back(where);
+        detail = "partitioned scan, " + to_string(prunePartitions(tableName, wheres).size()) + " of " + to_string(spec.count) + " partitions ("
+               + (spec.range ? "RANGE" : "HASH") + " on " + currentDatabase->schema(tableName).columns[spec.col].name + ")";
+    } else if(currentDatabase->pagedTables.count(tableName)) {
+        detail += ", page file (" + to_string(scanBlocks(tableName)) + " pages)";
+        auto zones = currentDatabase->pageZones.find(tableName);
+        if(where && !where->empty() && zones != currentDatabase->pageZones.end() && zones->second.size() == scanBlocks(tableName)) {
+            detail += ", zone maps";
+        }
+    } else {
+        const auto& table = readTable(tableName);
+        detail += ", in memory (" + to_string(table.size()) + " rows)";
+        if(where && !where->empty() && !table.zones().empty()) {
+            detail += ", zone maps";
+        }
+    }
+    return detail + estimate.str();
+}
+
+//扫描的块数: 页存储表为页数, 内存表为BLOCK_ROWS行一块
+size_t scanBlocks(const string& tableName)
+{
+    if(currentDatabase->partitions.count(tableName)) {
+        size_t blocks = 0;
+        for(const auto& part : prunePartitions(tableName, {})) blocks += scanBlocks(part);
+        return blocks;
+    }
+    if(currentDatabase->pagedTables.count(tableName)) {
+        return bufferPool.pageCount(currentDatabase->pageFile(tableName));
+    }
+    return (readTable(tableName).size() + BLOCK_ROWS - 1) / BLOCK_ROWS;
+}
+
+//EXPLAIN: WHERE谓词原文和每个条件的求值方式(向量化内核或逐行)
+//blocks为false时输入不是整块的行(如索引查找取出的单行), 不标内核
+static string describeFilter(const vector<string>& conditions, const ConditionSet& where, bool blocks)
+{
+    string detail;
+    for(const auto& word : conditions) {
+        detail += (detail.empty() ? "" : " ") + word;
+    }
+    detail += " [";
+    bool kernels = blocks && (where.logicalOp.empty() || where.logicalOp == "AND" || where.logicalOp == "OR");  // 同selectRows
+    for(size_t k = 0; k < where.conds.size(); ++k) {
+        const auto& c = where.conds[k];
+        bool vectorized = kernels && c.index != TableSchema::npos && c.cmp != CmpOp::OTHER && (integralType(c.type) || c.type == "FLOAT");
+        detail += (k ? ", " : "") + string(vectorized ? simdLevelName(simdLevel()) : "row-at-a-time");
+    }
+    return detail + "]";
+}
+
+static string csvField(const string& text)
+{
+    if(text.find_first_of(",\"\n") == string::npos) return text;
+    string quoted = "\"";
+    for(char c : text) {
+        quoted += c;
+        if(c == '"') quoted += '"';
+    }
+    return quoted + "\"";
+}
+
+//打开结果输出: 平时以追加方式打开结果文件; 并行执行时是当前语句自己的缓冲, 由执行器按语句顺序提交到结果文件
+unique_ptr<ostream> openOutput(const string& outputFile)
+{
+    if(outputBuffer) {
+        return make_unique<ostream>(outputBuffer);
+    }
+    auto file = make_unique<ofstream>(outputFile, ios::app);
+    if(!file->is_open()) {
+        cerr << "Unable to open file: " << outputFile << endl;
+        return nullptr;
+    }
+    file->seekp(0, ios::end);
+    return file;
+}
+
+//EXPLAIN的结果和查询结果一样追加到输出文件, 以---分隔
+void writePlan(const QueryPlan& plan, const string& outputFile)
+{
+    if(plan.nodes.empty()) {
+        return;  // 查询本身出错, 错误已经报告
+    }
+    auto out = openOutput(outputFile);
+    if(!out) {
+        return;
+    }
+    ostream& file = *out;
+    if(isprint)
+    {
+        file<<"---"<<endl;
+    }
+    else
+    {
+        isprint=true;
+    }
+    file << "id,operator,detail" << (plan.analyze ? ",rows_in,rows_out,loops,time_ms" : "") << endl;
+    file << fixed << setprecision(3);
+    for(size_t i = 0; i < plan.nodes.size(); ++i) {
+        const auto& node = plan.nodes[i];
+        string op = string(node.depth * 2, ' ') + (node.depth ? "-> " : "") + node.op;
+        file << i + 1 << "," << csvField(op) << "," << csvField(node.detail);
+        if(plan.analyze) {
+            file << ",";
+            if(node.hasRowsIn) file << node.rowsIn;
+            file << "," << node.rowsOut << "," << node.loops << "," << node.ms;
+        }
+        file << endl;
+    }
+}
+
+void create_database(const string& dbName)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if (databases.find(dbName) != databases.end()) {
+        cerr << "Database " << dbName << " already exists" << endl;
+        return;
+    }
+    databases[dbName] = Database(dbName);
+    save_database(databases[dbName]);
+}
+
+void use_database(const string dbName)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    string dbFileName = dbName + ".db";
+    ifstream file(dbFileName);
+    if (!file.is_open()) {
+        cerr << "Database " << dbName << " does not exist" << endl;
+        return;
+    }
+    file.close();
+
+    load_database(dbFileName);
+}
+
+void create_table(const string& tableName, const vector<string>& columns, const string& partitionBy = "") {
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(!currentDatabase) {
+        cerr << "No database selected" << endl;
+        return;
+    }
+    
+    if (currentDatabase->tables.find(tableName) != currentDatabase->tables.end()) {
+        cerr << "Table " << tableName << " already exists" << endl;
+        return;
+    }
+    if (Database::isPartition(tableName)) {
+        cerr << "Table name " << tableName << " must not contain #" << endl;
+        return;
+    }
+    
+    vector<Column> tableColumns;
+    vector<string> columnTypes;
+    vector<UniqueIndex> indexes;
+    
+    for(const auto& col : columns) {
+        istringstream iss(col);
+        string name, type, constraint, word;
+        iss >> name >> type;
+        while(iss >> word) constraint += (constraint.empty() ? "" : " ") + word;
+        // 列约束: PRIMARY KEY(每张表至多一个) 或 UNIQUE
+        if(constraint == "PRIMARY KEY" || constraint == "UNIQUE") {
+            bool primary = constraint == "PRIMARY KEY";
+            if(primary && any_of(indexes.begin(), indexes.end(), [](const UniqueIndex& index) { return index.primary; })) {
+                cerr << "Table " << tableName << " has more than one PRIMARY KEY" << endl;
+                return;
+            }
+            indexes.emplace_back(tableColumns.size(), primary);
+        } else if(!constraint.empty()) {
+            cerr << "Unknown constraint " << constraint << " on column " << name << endl;
+            return;
+        }
+        string normalized = normalizeType(type);
+        if(normalized.empty()) {
+            cerr << "Invalid type " << type << " for column " << name << ": DECIMAL(p,s) needs 1 <= p <= " << MAX_DECIMAL_PRECISION << " and 0 <= s <= p" << endl;
+            return;
+        }
+        tableColumns.push_back({name, normalized});
+        columnTypes.push_back(normalized);
+    }
+    
+    PartitionSpec spec;
+    if(!partitionBy.empty() && !parsePartitionBy(tableName, partitionBy, tableColumns, indexes, spec)) {
+        return;
+    }
+    
+    currentDatabase->tables[tableName] = make_shared<RowStore>(columnTypes);
+    currentDatabase->setColumns(tableName, tableColumns);  // 存储列名和类型
+    if(!partitionBy.empty()) {
+        // 分区是同结构的子表; 唯一约束只能在分区列上, 每个分区各建自己的索引
+        for(size_t k = 0; k < spec.count; ++k) {
+            string part = PartitionSpec::partName(tableName, k);
+            currentDatabase->tables[part] = make_shared<RowStore>(columnTypes);
+            currentDatabase->setColumns(part, tableColumns);
+            if(!indexes.empty()) currentDatabase->uniqueIndexes[part] = indexes;
+            touchTable(part);
+        }
+        currentDatabase->partitions[tableName] = move(spec);
+    } else if(!indexes.empty()) {
+        currentDatabase->uniqueIndexes[tableName] = move(indexes);
+    }
+    touchTable(tableName);
+    save_database(*currentDatabase);
+}
+
+//PARTITION BY HASH(列) [PARTITIONS n] 或 PARTITION BY RANGE(列) (上界, ...); 出错时报告并返回false
+bool parsePartitionBy(const string& tableName, const string& clause, const vector<Column>& columns, const vector<UniqueIndex>& indexes, PartitionSpec& spec)
+{
+    string text = clause;
+    for(char& c : text) {
+        if(c == '(' || c == ')' || c == ',') c = ' ';
+    }
+    istringstream iss(text);
+    string partition, by, kind, column, word;
+    iss >> partition >> by >> kind >> column;
+    if(partition != "PARTITION" || by != "BY" || (kind != "HASH" && kind != "RANGE") || column.empty()) {
+        cerr << "Invalid PARTITION BY clause: " << clause << endl;
+        return false;
+    }
+    auto found = find_if(columns.begin(), columns.end(), [&](const Column& c) { return c.name == column; });
+    if(found == columns.end()) {
+        cerr << "Column " << column << " does not exist" << endl;
+        return false;
+    }
+    spec.range = kind == "RANGE";
+    spec.col = found - columns.begin();
+    spec.type = found->type;
+    if(!spec.range) {
+        spec.count = DEFAULT_PARTITIONS;
+        if(iss >> word && (word != "PARTITIONS" || !(iss >> spec.count) || spec.count == 0 || spec.count > MAX_PARTITIONS || iss >> word)) {
+            cerr << "Invalid PARTITION BY clause: " << clause << endl;
+            return false;
+        }
+    } else {
+        if(spec.type != "INTEGER" && spec.type != "FLOAT") {
+            cerr << "RANGE partitioning needs an INTEGER or FLOAT column" << endl;
+            return false;
+        }
+        while(iss >> word) {
+            int64_t v;
+            bool valid = spec.type == "INTEGER" ? RowStore::parseInteger(word, v) : true;
+            try {
+                if(spec.type == "FLOAT") parseFloat(word);
+            } catch(...) {
+                valid = false;
+            }
+            if(!valid || (!spec.bounds.empty() && !spec.below(spec.bounds.back(), word))) {
+                cerr << "RANGE bounds must be increasing numbers: " << clause << endl;
+                return false;
+            }
+            spec.bounds.push_back(spec.type == "INTEGER" ? to_string(v) : word);
+        }
+        spec.count = spec.bounds.size() + 1;
+        if(spec.bounds.empty() || spec.count > MAX_PARTITIONS) {
+            cerr << "Invalid PARTITION BY clause: " << clause << endl;
+            return false;
+        }
+    }
+    for(const auto& index : indexes) {
+        if(index.col != spec.col) {
+            cerr << index.label() << " column " << columns[index.col].name << " of partitioned table " << tableName
+                 << " must be the partition column" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+void drop_table(const string& tableName)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(currentDatabase)
+    {
+        if (currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
+            cerr << "Table " << tableName << " does not exist" << endl;
+            return;
+        }
+        // 分区表连同各分区一起删除
+        vector<string> names{tableName};
+        auto partitioned = currentDatabase->partitions.find(tableName);
+        if(partitioned != currentDatabase->partitions.end()) {
+            for(size_t k = 0; k < partitioned->second.count; ++k) names.push_back(PartitionSpec::partName(tableName, k));
+            currentDatabase->partitions.erase(partitioned);
+        }
+        for(const auto& name : names) {
+            string pageFile = currentDatabase->pageFile(name);
+            currentDatabase->tables.erase(name);
+            chargeTable(name);
+            currentDatabase->dropColumns(name);
+            currentDatabase->pagedTables.erase(name);
+            string zoneFile = currentDatabase->zoneFile(name);
+            currentDatabase->pageZones.erase(name);
+            currentDatabase->tableStats.erase(name);
+            currentDatabase->tableVersions.erase(name);
+            currentDatabase->uniqueIndexes.erase(name);
+            bufferPool.discard(pageFile);
+            remove(pageFile.c_str());
+            remove(zoneFile.c_str());
+            remove(currentDatabase->overflowFile(name).c_str());
+            remove(currentDatabase->statsFile(name).c_str());
+        }
+        save_database(*currentDatabase);
+    }
+    else
+    {
+        cerr<<"No database selected"<<endl;
+    
+    }
+}
+
+void insert_into_table(const string& tableName, const ArenaRow& values)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(currentDatabase)
+    {
+        if(currentDatabase->tables.find(tableName)!=currentDatabase->tables.end())
+        {
+            if(values.size() != currentDatabase->schema(tableName).size()) {
+                cerr << "Column count does not match table " << tableName << endl;
+                return;
+            }
+            ArenaRow cleanValues(StatementArena::get());
+            cleanValues.reserve(values.size());
+        for(size_t i = 0; i < values.size(); ++i) {
+            pmr::string cleanValue(values[i], StatementArena::get());
+            // 根据列类型处理数据
+            string colType = currentDatabase->schema(tableName).types[i];
+            
+           // 去除逗号
+            while(!cleanValue.empty() && (cleanValue.back() == ',' || cleanValue.back() == ' ')) {
+                cleanValue.pop_back();
+            }
+
+            // 如果是TEXT类型，确保字符串被单引号包裹
+            if(colType == "TEXT") {
+                if(cleanValue.front() != '\'' || cleanValue.back() != '\'') {
+                    cerr << "Invalid TEXT value format: " << cleanValue << endl;
+                    return;
+                }
+            }
+            // INTEGER按内联整数存储, 这里统一成规范写法
+            if(colType == "INTEGER") {
+                int64_t v;
+                if(!RowStore::parseInteger(string(cleanValue), v)) {
+                    cerr << "Invalid INTEGER value format: " << cleanValue << endl;
+                    return;
+                }
+                cleanValue.assign(to_string(v));
+            }
+            // DECIMAL四舍五入到s位小数, 存为规范写法; 超出p位有效数字的值拒绝
+            int precision = 0, scale = 0;
+            if(decimalType(colType, precision, scale)) {
+                DecimalValue d;
+                if(!parseDecimal(cleanValue, scale, d)) {
+                    cerr << "Invalid DECIMAL value format: " << cleanValue << endl;
+                    return;
+                }
+                if(!decimalFits(d.rounded, precision)) {
+                    cerr << "Value " << cleanValue << " out of range for " << colType << endl;
+                    return;
+                }
+                cleanValue.assign(formatDecimal(d.rounded, scale));
+            }
+            
+            cleanValues.push_back(std::move(cleanValue));
+        }
+            if(!Page::fits(cleanValues)) {
+                cerr << "Row too large for a page in table " << tableName << endl;
+                return;
+            }
+            // 分区表: 行写入分区列的值所在的分区
+            string target = tableName;
+            auto partitioned = currentDatabase->partitions.find(tableName);
+            if(partitioned != currentDatabase->partitions.end()) {
+                const PartitionSpec& spec = partitioned->second;
+                target = PartitionSpec::partName(tableName, spec.partitionOf(cleanValues[spec.col]));
+            }
+            // PRIMARY KEY/UNIQUE: 在哈希索引中查新值, 已存在时拒绝插入
+            vector<pair<UniqueIndex*, string>> keys;
+            auto indexes = currentDatabase->uniqueIndexes.find(target);
+            if(indexes != currentDatabase->uniqueIndexes.end()) {
+                for(auto& index : indexes->second) {
+                    string key = indexKey(currentDatabase->schema(tableName).types[index.col], cleanValues[index.col]);
+                    if(ensureIndex(target, index).rows.count(key)) {
+                        cerr << "Duplicate value " << cleanValues[index.col] << " for " << index.label() << " column "
+                             << currentDatabase->schema(tableName).columns[index.col].name << " in table " << tableName << endl;
+                        return;
+                    }
+                    keys.push_back({&index, key});
+                }
+            }
+            uint64_t location;
+            if(currentDatabase->pagedTables.count(target)) {
+                location = appendToPages(target, cleanValues);
+            } else {
+                auto& table = *currentDatabase->tables[target];
+                table.append(cleanValues);
+                location = table.size() - 1;
+            }
+            for(auto& key : keys) key.first->rows.emplace(key.second, location);
+            profiler.addEmitted(1);
+            if(target != tableName) touchTable(target);
+            touchTable(tableName);
+            save_database(*currentDatabase);
+        }
+        else
+        {
+            cerr<<"Table "<<tableName<<" does not exist"<<endl;
+        }
+    }
+    else
+    {
+        cerr<<"No database selected"<<endl;
+    }
+}
+
+//********** 算子流水线 **********
+//查询由物理算子串成: 扫描 -> 过滤 -> 连接 -> 投影 -> 输出, 行按批从上游推给下游, 每批约BLOCK_ROWS行
+//每个算子记录ANALYZE用的行数、调用次数和自身耗时, EXPLAIN直接从算子树生成计划
+class Pipeline;
+
+class Operator {
+public:
+    Operator(Pipeline& pipeline, Phase phase, string name, string detail, bool hasRowsIn = true)
+        : name(std::move(name)), detail(std::move(detail)), hasRowsIn(hasRowsIn), pipeline(pipeline), phase(phase) {}
+    virtual ~Operator() = default;
+
+    Operator* next = nullptr;      // 下游算子, 为空时是汇点
+    vector<Operator*> children;    // 计划树中的上游算子
+    string name, detail;
+    bool hasRowsIn;
+    size_t rowsIn = 0, rowsOut = 0, loops = 0;
+    double ms = 0;
+    Operator* chargeTo = this;     // 自身耗时记在哪个算子上
+
+    void accept(Batch& batch) {
+        rowsIn += batch.count;
+        loops++;
+        timed([&] { process(batch); });
+    }
+
+    // 上游已经推完所有批: 先输出缓存的结果, 再通知下游
+    void end() {
+        timed([&] { flush(); });
+        if(next) next->end();
+    }
+
+    void describe(QueryPlan& plan, int depth) const {
+        plan.nodes.push_back({name, planDetail(), depth, hasRowsIn, rowsIn, rowsOut, loops, ms});
+        for(const auto* child : children) {
+            child->describe(plan, depth + 1);
+        }
+    }
+
+protected:
+    virtual void process(Batch& batch) = 0;
+    virtual void flush() {}
+    virtual string planDetail() const { return detail; }
+
+    void emit(Batch& batch) {
+        rowsOut += batch.count;
+        if(next && batch.count) next->accept(batch);
+    }
+
+    // 连接的结果可能远多于一批, 按BLOCK_ROWS行一批分段推给下游
+    void emitChunked(const Batch& all) {
+        for(size_t start = 0; start < all.count; start += BLOCK_ROWS) {
+            size_t end = min(all.count, start + BLOCK_ROWS);
+            chunk.reset(all.tables, all.stable);
+            for(size_t t = 0; t < all.rows.size(); ++t) {
+                chunk.rows[t].assign(all.rows[t].begin() + start, all.rows[t].begin() + end);
+            }
+            chunk.count = end - start;
+            emit(chunk);
+        }
+    }
+
+    // ANALYZE计时: 下游算子在fn中花掉的时间不计入自身
+    template<typename Fn>
+    void timed(Fn fn) {
+        ProfileScope scope(pipeline.db.profiler, phase);
+        if(!pipeline.analyze()) {
+            fn();
+            return;
+        }
+        double started = planClock(pipeline.plan), outerNested = pipeline.nestedMs;
+        pipeline.nestedMs = 0;
+        fn();
+        double total = planClock(pipeline.plan) - started;
+        chargeTo->ms += total - pipeline.nestedMs;
+        pipeline.nestedMs = outerNested + total;
+    }
+
+    Pipeline& pipeline;
+    Phase phase;
+    Batch chunk;
+};
+
+class Pipeline {
+public:
+    Pipeline(MiniDB& db, QueryPlan* plan) : db(db), plan(plan) {}
+
+    MiniDB& db;
+    QueryPlan* plan;
+    double nestedMs = 0;  // 当前算子执行期间, 被它调用的算子已经计入的时间
+
+    bool analyze() const { return plan && plan->analyze; }
+
+    template<typename T, typename... Args>
+    T* add(Args&&... args) {
+        operators.push_back(make_unique<T>(*this, std::forward<Args>(args)...));
+        return static_cast<T*>(operators.back().get());
+    }
+
+    static void chain(Operator* from, Operator* to) {
+        from->next = to;
+        to->children.push_back(from);
+    }
+
+private:
+    vector<unique_ptr<Operator>> operators;
+};
+
+//扫描: 源算子, 每个块(页存储表为攒够一批的若干页)作为一个稠密批推出; 按where跳过块统计排除的块
+//columns为查询用到的列, 页存储的表只解码这些列; 为空时解码所有列
+//共享扫描给出多条查询的WHERE, 只跳过所有查询都排除的块
+class ScanOp : public Operator {
+public:
+    ScanOp(Pipeline& pipeline, const string& tableName, const ConditionSet* where, vector<bool> columns, const string& role = "")
+        : ScanOp(pipeline, tableName, where ? vector<const ConditionSet*>{where} : vector<const ConditionSet*>{}, std::move(columns),
+                 role, pipeline.db.describeScan(tableName, where)) {
+        index = pipeline.db.lookupIndex(tableName, where);
+    }
+
+    ScanOp(Pipeline& pipeline, const string& tableName, vector<const ConditionSet*> wheres, vector<bool> columns)
+        : ScanOp(pipeline, tableName, std::move(wheres), std::move(columns), " (shared)", pipeline.db.describeScan(tableName, nullptr)) {}
+
+    void run() {
+        loops++;
+        timed([&] {
+            if(index) {
+                pipeline.db.lookupRow(tableName, *index, wheres[0]->conds[0], [&](const RowStore& rows, size_t begin, size_t end) {
+                    batch.reset({&rows}, stable);
+                    batch.rows.clear();
+                    batch.begin = begin;
+                    batch.count = end - begin;
+                    emit(batch);
+                }, &blocks, columns.empty() ? nullptr : &columns);
+                return;
+            }
+            pipeline.db.scanTableShared(tableName, [&](const RowStore& rows, size_t begin, size_t end, const vector<bool>& wanted) {
+                this->wanted = &wanted;
+                batch.reset({&rows}, stable);
+                batch.rows.clear();
+                batch.begin = begin;
+                batch.count = end - begin;
+                emit(batch);
+            }, wheres, &blocks, columns.empty() ? nullptr : &columns);
+        });
+    }
+
+    // 共享扫描中当前这一批对各条查询是否有用(块统计没有排除), 见scanTableShared
+    const vector<bool>* wanted = nullptr;
+
+protected:
+    void process(Batch&) override {}  // 源算子没有输入
+
+    string planDetail() const override {
+        if(!pipeline.analyze()) return detail;
+        return detail + ", " + to_string(blocks) + " of " + to_string(pipeline.db.scanBlocks(tableName) * loops) + " blocks read";
+    }
+
+public:
+    // 按索引查找时推出的是取到的单行, 不是整块
+    bool indexLookup() const { return index != nullptr; }
+
+protected:
+
+private:
+    ScanOp(Pipeline& pipeline, const string& tableName, vector<const ConditionSet*> wheres, vector<bool> columns, const string& role, const string& detail)
+        : Operator(pipeline, Phase::SCAN, "Scan " + tableName + role, detail, false),
+          tableName(tableName), wheres(std::move(wheres)), columns(std::move(columns)),
+          stable(!pipeline.db.currentDatabase->pagedTables.count(tableName) && !pipeline.db.currentDatabase->partitions.count(tableName)) {
+        size_t decoded = count(this->columns.begin(), this->columns.end(), true);
+        if(!stable && decoded < this->columns.size()) {
+            this->detail += ", " + to_string(decoded) + " of " + to_string(this->columns.size()) + " columns decoded";
+        }
+    }
+
+    string tableName;
+    vector<const ConditionSet*> wheres;
+    vector<bool> columns;
+    bool stable;
+    UniqueIndex* index = nullptr;  // WHERE是唯一索引列上的等值条件时按索引直接取行
+    size_t blocks = 0;
+    Batch batch;
+};
+
+//过滤: 对批中第一个表的行求WHERE; 扫描推出的整块走向量化的selectRows, 索引查找取出的单行和其余批逐行求值
+class FilterOp : public Operator {
+public:
+    FilterOp(Pipeline& pipeline, const ConditionSet& where, vector<string> conditions)
+        : Operator(pipeline, Phase::FILTER, "Filter", ""), where(where), conditions(std::move(conditions)) {}
+
+protected:
+    void process(Batch& batch) override {
+        const RowStore& rows = *batch.tables[0];
+        out.reset(batch.tables, batch.stable);
+        auto& selected = out.rows[0];
+        if(batch.rows.empty() && blockInput()) {
+            pipeline.db.selectRows(rows, batch.begin, batch.begin + batch.count, where, bits);
+            forEachSelected(bits, [&](size_t k) { selected.push_back(batch.begin + k); });
+        } else if(batch.rows.empty()) {
+            for(size_t r = batch.begin; r < batch.begin + batch.count; ++r) {
+                if(pipeline.db.evaluateConditions(rows, r, where)) selected.push_back(r);
+            }
+        } else {
+            for(size_t r : batch.rows[0]) {
+                if(pipeline.db.evaluateConditions(rows, r, where)) selected.push_back(r);
+            }
+        }
+        out.count = selected.size();
+        emit(out);
+    }
+
+    string planDetail() const override {
+        return pipeline.db.describeFilter(conditions, where, blockInput());
+    }
+
+    // 上游是按索引查找的扫描时只有取到的单行, 没有整块可交给向量化内核
+    bool blockInput() const {
+        const ScanOp* scan = children.size() == 1 ? dynamic_cast<const ScanOp*>(children[0]) : nullptr;
+        return !(scan && scan->indexLookup());
+    }
+
+private:
+    ConditionSet where;
+    vector<string> conditions;
+    vector<uint64_t> bits;
+    Batch out;
+};
+
+//投影: 把每个元组的输出列拼成CSV行; 列为(批中的表序号, 列序号), 列序号为npos时输出空字段
+class ProjectOp : public Operator {
+public:
+    ProjectOp(Pipeline& pipeline, vector<pair<size_t,size_t>> columns, const string& detail)
+        : Operator(pipeline, Phase::OUTPUT, "Project", detail), columns(std::move(columns)) {}
+
+protected:
+    void process(Batch& batch) override {
+        batch.text.clear();
+        for(size_t k = 0; k < batch.count; ++k) {
+            for(size_t j = 0; j < columns.size(); ++j) {
+                size_t t = columns[j].first, col = columns[j].second;
+                if(col != TableSchema::npos) {
+                    batch.tables[t]->appendTo(batch.text, batch.row(t, k), col);
+                }
+                if(j < columns.size() - 1) batch.text += ",";
+            }
+            batch.text += "\n";
+        }
+        emit(batch);
+    }
+
+private:
+    vector<pair<size_t,size_t>> columns;
+};
+
+//输出: 汇点, 把投影好的行追加到结果文件(共享扫描时可能先写到内存); EXPLAIN ANALYZE时file为空, 只计数
+//capture非空时同时记下结果, 供结果缓存使用
+class OutputOp : public Operator {
+public:
+    OutputOp(Pipeline& pipeline, ostream* file, const string& detail, ResultCache::Capture* capture = nullptr)
+        : Operator(pipeline, Phase::OUTPUT, "Output", detail), file(file), capture(capture) {}
+
+protected:
+    void process(Batch& batch) override {
+        if(file) *file << batch.text;
+        if(capture) {
+            capture->text += batch.text;
+            capture->rows += batch.count;
+        }
+        pipeline.db.profiler.addEmitted(batch.count);
+        emit(batch);
+    }
+
+private:
+    ostream* file;
+    ResultCache::Capture* capture;
+};
+
+//收集: 库接口取结果时代替 Project -> Output 的汇点, 把每个元组的输出列按类型复制到结果集; 列的含义同ProjectOp
+class CollectOp : public Operator {
+public:
+    CollectOp(Pipeline& pipeline, vector<pair<size_t,size_t>> columns, RowStore& rows, const string& detail)
+        : Operator(pipeline, Phase::OUTPUT, "Collect", detail), columns(std::move(columns)), rows(rows) {}
+
+protected:
+    void process(Batch& batch) override {
+        for(size_t k = 0; k < batch.count; ++k) {
+            cells.clear();
+            for(const auto& column : columns) {
+                size_t t = column.first, col = column.second;
+                cells.push_back({col == TableSchema::npos ? nullptr : batch.tables[t], batch.row(t, k), col});
+            }
+            rows.appendCells(cells);
+        }
+        pipeline.db.profiler.addEmitted(batch.count);
+        emit(batch);
+    }
+
+private:
+    vector<pair<size_t,size_t>> columns;
+    RowStore& rows;
+    vector<RowStore::Cell> cells;
+};
+
+//共享扫描的分发: 把扫描推来的每一批依次交给各条查询的流水线, 跳过块统计排除了的查询; 不出现在计划中
+class TeeOp : public Operator {
+public:
+    TeeOp(Pipeline& pipeline) : Operator(pipeline, Phase::SCAN, "", "") {}
+
+    const ScanOp* source = nullptr;  // 第i个分支对应扫描的第i个WHERE
+
+    void add(Operator* branch) {
+        branches.push_back(branch);
+        branch->children.push_back(this);
+    }
+
+protected:
+    void process(Batch& batch) override {
+        const vector<bool>* wanted = source ? source->wanted : nullptr;
+        for(size_t i = 0; i < branches.size(); ++i) {
+            if(!wanted || wanted->empty() || (*wanted)[i]) branches[i]->accept(batch);
+        }
+    }
+
+    void flush() override {
+        for(auto* branch : branches) branch->end();
+    }
+
+private:
+    vector<Operator*> branches;
+};
+
+//把推来的批交给回调, 不出现在计划中, 耗时记到owner上(嵌套循环连接接收内表的批)
+class CallbackOp : public Operator {
+public:
+    CallbackOp(Pipeline& pipeline, Operator* owner, function<void(Batch&)> fn)
+        : Operator(pipeline, Phase::JOIN, "", ""), fn(std::move(fn)) { chargeTo = owner; }
+
+protected:
+    void process(Batch& batch) override { fn(batch); }
+
+private:
+    function<void(Batch&)> fn;
+};
+
+//块嵌套循环连接: 上游每推来一批, 重新执行一遍内表的扫描流水线, 逐对检查这一步的ON条件
+//只记匹配的行号; 页存储的内表的批在扫描结束后失效, 匹配的行(只带用到的列)复制出来
+//结果按上游元组稳定排序, 与逐行嵌套循环的输出顺序相同; 复制的行和排序缓冲计入语句的工作内存
+class NestedLoopJoinOp : public Operator {
+public:
+    NestedLoopJoinOp(Pipeline& pipeline, const JoinSpec& spec, size_t step, const string& detail)
+        : Operator(pipeline, Phase::JOIN, "Nested Loop Join", detail), spec(spec), step(spec.steps[step]),
+          innerRows(pipeline.db.currentDatabase->schema(spec.tables[spec.steps[step].table]).types, false),
+          memory(pipeline.db.memory, "nested loop join with " + spec.tables[spec.steps[step].table]) {}
+
+    void setInner(ScanOp* scan, Operator* last) {
+        inner = scan;
+        Pipeline::chain(last, pipeline.add<CallbackOp>(this, [this](Batch& batch) { probeInner(batch); }));
+        children.push_back(last);
+    }
+
+protected:
+    void process(Batch& batch) override {
+        outer = &batch;
+        innerRows.clear();
+        pairs.clear();
+        inner->run();
+        stable_sort(pairs.begin(), pairs.end(), [](const pair<size_t,size_t>& a, const pair<size_t,size_t>& b) { return a.first < b.first; });
+        tables = batch.tables;
+        tables.push_back(innerStore);
+        out.reset(tables, batch.stable && innerStore != &innerRows);
+        for(const auto& p : pairs) {
+            for(size_t t = 0; t < batch.tables.size(); ++t) {
+                out.rows[t].push_back(batch.row(t, p.first));
+            }
+            out.rows.back().push_back(p.second);
+        }
+        out.count = pairs.size();
+        memory.set(innerRows.memoryBytes() + pairs.capacity() * sizeof(pairs[0]) + out.count * tables.size() * sizeof(size_t));
+        emitChunked(out);
+    }
+
+private:
+    void probeInner(Batch& batch) {
+        const RowStore& rows = *batch.tables[0];
+        innerStore = batch.stable ? &rows : &innerRows;
+        copied.assign(batch.count, NO_ROW);
+        for(size_t k = 0; k < outer->count; ++k) {
+            for(size_t m = 0; m < batch.count; ++m) {
+                size_t j = batch.row(0, m);
+                auto locate = [&](size_t t) {
+                    if(t == step.table) return RowRef(&rows, j);
+                    size_t p = spec.position[t];
+                    return RowRef(outer->tables[p], outer->row(p, k));
+                };
+                if(!keysMatch(spec, step.keys, 0, locate)) {
+                    continue;
+                }
+                if(batch.stable) {
+                    pairs.push_back({k, j});
+                    continue;
+                }
+                if(copied[m] == NO_ROW) {
+                    copied[m] = innerRows.size();
+                    innerRows.appendFrom(rows, j, spec.columns[step.table]);
+                }
+                pairs.push_back({k, copied[m]});
+            }
+        }
+    }
+
+    static constexpr size_t NO_ROW = numeric_limits<size_t>::max();
+    const JoinSpec& spec;
+    const JoinStep& step;
+    ScanOp* inner = nullptr;
+    Batch* outer = nullptr;
+    RowStore innerRows;
+    const RowStore* innerStore = &innerRows;  // 内存表为表本身, 否则为innerRows
+    vector<size_t> copied;
+    vector<pair<size_t,size_t>> pairs;  // (上游批中的序号, innerStore中的行)
+    vector<const RowStore*> tables;
+    Batch out;
+    MemoryReservation memory;
+};
+
+//哈希表: 建表侧的汇点; 内存表只记行号, 页存储表的行(只带用到的列)复制到内存
+//全部到齐后按连接列串成链, 同一个键的行倒序插入链表头, 链上的行保持扫描顺序; 哈希表的结点分配在语句临时内存上
+//占用超出语句的内存预算时改为分区(Grace)哈希连接: 已收到的和之后的行按连接列的哈希写入SPILL_PARTITIONS个临时文件,
+//探测侧同样分区落盘, 之后逐个分区读回建表、探测(见HashJoinOp); 读回仍然超出预算的分区换一种哈希再分
+class HashBuildOp : public Operator {
+public:
+    HashBuildOp(Pipeline& pipeline, const vector<string>& types, size_t key, bool intKey, int64_t factor, int64_t probeFactor,
+                const vector<size_t>& columns, size_t headroom, const string& detail)
+        : Operator(pipeline, Phase::JOIN, "Hash", detail), intKey(intKey), factor(factor), probeFactor(probeFactor), key(key), columns(columns), types(types), rows(types, false),
+          memory(pipeline.db.memory, "hash table on " + detail), headroom(headroom) {}
+
+    static constexpr size_t NO_ROW = numeric_limits<size_t>::max();
+    vector<size_t> nextRow;  // 按建表顺序编号的链
+    BloomFilter bloom;       // 所有连接列的值, 供探测侧扫描时预先过滤; 落盘时不建
+    const bool intKey;
+    const int64_t factor, probeFactor;  // 整数键换算到共同小数位数所乘的倍数: 建表侧和探测侧
+
+    size_t size() const { return source ? ids.size() : rows.size(); }
+    const RowStore& store() const { return source ? *source : rows; }
+    size_t rowId(size_t b) const { return source ? ids[b] : b; }  // 第b行在store()中的行号
+
+    // 与probe表第row行连接列相等的第一行(建表顺序的编号), 沿nextRow继续
+    size_t find(const RowStore& probe, size_t row, size_t probeKey) const {
+        if(intKey) {
+            auto it = intHeads->find(scaleKey(probe.integer(row, probeKey), probeFactor));
+            return it == intHeads->end() ? NO_ROW : it->second;
+        }
+        auto it = textHeads->find(probe.text(row, probeKey));
+        return it == textHeads->end() ? NO_ROW : it->second;
+    }
+
+    bool spilled() const { return !partitions.empty(); }
+
+    // 落盘时行所在的分区: 取连接列哈希的高位, 与Bloom过滤器用到的位错开
+    // 第depth层再分时先按depth把哈希重新打散, 上一层落在同一个分区的键在这一层分开
+    static size_t partitionOf(uint64_t hash, size_t depth = 0) {
+        if(depth) {
+            hash ^= depth * 0x9e3779b97f4a7c15ULL;
+            hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+            hash ^= hash >> 31;
+        }
+        return (hash >> 40) % SPILL_PARTITIONS;
+    }
+
+    SpillFile& partition(size_t p) { return *partitions[p]; }
+
+    // 落盘后: 读回一个分区, 重建为只含这个分区的行的哈希表; seq[b]为第b行在建表侧的到达序号
+    // 超出预算时放开读回的行, 返回false
+    bool loadPartition(SpillFile& file, vector<uint64_t>& seq) {
+        clearRows();
+        seq.clear();
+        file.startReading();
+        while(file.read(record)) {
+            uint64_t arrival;
+            memcpy(&arrival, record.data(), 8);
+            seq.push_back(arrival);
+            rows.appendEncoded(record.data() + 8, columns);
+        }
+        size_t needed = footprint(size()) + seq.capacity() * sizeof(uint64_t);
+        if(!memory.trySet(needed)) {
+            clearRows();
+            seq = vector<uint64_t>();
+            memory.set(0);
+            unfit = needed;
+            return false;
+        }
+        buildChains(false);
+        return true;
+    }
+
+    // 连接放不下的分区按第depth层的哈希再分, 记录原样写入各个子分区; singleKey为分区中的行连接列是否都相同(再分也分不开)
+    vector<unique_ptr<SpillFile>> repartition(SpillFile& file, size_t depth, bool& singleKey) {
+        vector<unique_ptr<SpillFile>> parts;
+        for(size_t p = 0; p < SPILL_PARTITIONS; ++p) parts.push_back(make_unique<SpillFile>(pipeline.db.profiler));
+        singleKey = true;
+        RowStore first(types, false);
+        file.startReading();
+        while(file.read(record)) {
+            rows.clear();
+            rows.appendEncoded(record.data() + 8, columns);
+            if(first.size() == 0) {
+                first.appendFrom(rows, 0, columns);
+            } else if(singleKey) {
+                singleKey = intKey ? rows.integer(0, key) == first.integer(0, key) : rows.text(0, key) == first.text(0, key);
+            }
+            parts[partitionOf(BloomFilter::hashKey(rows, 0, key, intKey, factor), depth)]->write(record);
+        }
+        rows.clear();
+        return parts;
+    }
+
+    // 读回的分区再分也装不下: 以它所需的字节数报错
+    [[noreturn]] void fail(const string& note) const { memory.fail(unfit, note); }
+
+    // 连接的结果都已推出, 不再用哈希表: 放开它和登记的内存, 下游的连接(如逐个分区读回时)可以用这部分预算
+    void release() {
+        clearRows();
+        memory.set(0);
+    }
+
+protected:
+    void process(Batch& batch) override {
+        if(spilled()) {
+            for(size_t k = 0; k < batch.count; ++k) spillRow(*batch.tables[0], batch.row(0, k));
+            return;
+        }
+        for(size_t k = 0; k < batch.count; ++k) {
+            if(batch.stable) {
+                source = batch.tables[0];
+                ids.push_back(batch.row(0, k));
+            } else {
+                rows.appendFrom(*batch.tables[0], batch.row(0, k), columns);
+            }
+        }
+        if(!fits(footprint(0))) spill();
+    }
+
+    void flush() override {
+        if(!spilled() && !fits(footprint(size()))) spill();
+        if(spilled()) {
+            rowsOut = arrived;
+            uint64_t bytes = 0;
+            for(const auto& file : partitions) bytes += file->bytes;
+            pipeline.db.memory.noteSpill(bytes);
+            return;
+        }
+        bloom = BloomFilter(size());
+        buildChains(true);
+        rowsOut = size();
+        hashedIds = source != nullptr;
+    }
+
+    string planDetail() const override {
+        if(!pipeline.analyze()) return detail;
+        if(spilled()) return detail + ", over memory budget: " + to_string(arrived) + " rows spilled to " + to_string(SPILL_PARTITIONS) + " partitions";
+        return detail + ", " + to_string(rowsOut) + (hashedIds ? " row ids hashed" : " rows hashed");
+    }
+
+private:
+    size_t key;
+    const vector<size_t>& columns;
+    vector<string> types;
+    RowStore rows;
+    const RowStore* source = nullptr;  // 内存表
+    vector<size_t> ids;
+    optional<pmr::unordered_map<int64_t, size_t>> intHeads;
+    optional<pmr::unordered_map<string_view, size_t>> textHeads;
+    MemoryReservation memory;
+    size_t headroom;  // 哈希表之外给连接留的预算: 一批结果的行号
+    vector<unique_ptr<SpillFile>> partitions;  // 落盘后每个分区一个临时文件, 记录为 8字节到达序号 + 用到的列
+    uint64_t arrived = 0;  // 落盘后: 已写出的行数
+    size_t unfit = 0;      // 上一个读回时超出预算的分区所需的字节数
+    bool hashedIds = false;  // 没有落盘时: 哈希表记的是内存表的行号
+    string record;
+
+    // 登记bytes字节, 预算中还要留得下headroom
+    bool fits(size_t bytes) {
+        if(!memory.trySet(bytes + headroom)) return false;
+        memory.set(bytes);
+        return true;
+    }
+
+    // 已收到的行加上为hashed行建链所需的内存
+    size_t footprint(size_t hashed) const {
+        return rows.memoryBytes() + ids.capacity() * sizeof(size_t) + hashed * HASH_ENTRY_BYTES;
+    }
+
+    void buildChains(bool withBloom) {
+        const RowStore& hashed = store();
+        nextRow.assign(size(), NO_ROW);
+        // 落盘后逐个分区重建, 结点放在堆上, 随上一个分区的哈希表一起释放
+        pmr::memory_resource* resource = spilled() ? pmr::get_default_resource() : StatementArena::get();
+        if(intKey) {
+            intHeads.emplace(resource);
+            intHeads->reserve(size());
+        } else {
+            textHeads.emplace(resource);
+            textHeads->reserve(size());
+        }
+        for(size_t b = size(); b-- > 0;) {
+            size_t& head = intKey ? intHeads->try_emplace(scaleKey(hashed.integer(rowId(b), key), factor), NO_ROW).first->second
+                                  : textHeads->try_emplace(hashed.text(rowId(b), key), NO_ROW).first->second;
+            nextRow[b] = head;
+            head = b;
+            if(withBloom) bloom.add(BloomFilter::hashKey(hashed, rowId(b), key, intKey, factor));
+        }
+    }
+
+    // 超出预算: 已收到的行按到达顺序写入各自的分区, 释放内存; 之后的行直接写入分区
+    void spill() {
+        for(size_t p = 0; p < SPILL_PARTITIONS; ++p) partitions.push_back(make_unique<SpillFile>(pipeline.db.profiler));
+        const RowStore& held = store();
+        for(size_t b = 0; b < size(); ++b) spillRow(held, rowId(b));
+        clearRows();
+        memory.set(0);
+    }
+
+    void spillRow(const RowStore& from, size_t r) {
+        record.assign(reinterpret_cast<const char*>(&arrived), 8);
+        from.encodeTo(record, r, columns);
+        partitions[partitionOf(BloomFilter::hashKey(from, r, key, intKey, factor))]->write(record);
+        arrived++;
+    }
+
+    void clearRows() {
+        rows = RowStore(types, false);
+        source = nullptr;
+        ids = vector<size_t>();
+        nextRow = vector<size_t>();
+        intHeads.reset();
+        textHeads.reset();
+    }
+};
+
+//Bloom过滤器半连接: 驱动表的行先查建表侧的Bloom过滤器, 连接列不可能匹配的行在任何连接工作之前丢掉
+//开头BLOOM_SAMPLE_ROWS行中通过的超过3/4时过滤没有效果, 之后不再检查
+class BloomFilterOp : public Operator {
+public:
+    BloomFilterOp(Pipeline& pipeline, const HashBuildOp* build, size_t key, bool intKey, const string& detail)
+        : Operator(pipeline, Phase::FILTER, "Bloom Filter", detail), build(build), key(key), intKey(intKey) {}
+
+protected:
+    void process(Batch& batch) override {
+        if(disabled || build->spilled()) {
+            emit(batch);
+            return;
+        }
+        const RowStore& rows = *batch.tables[0];
+        out.reset(batch.tables, batch.stable);
+        for(size_t k = 0; k < batch.count; ++k) {
+            size_t r = batch.row(0, k);
+            if(build->bloom.mayContain(BloomFilter::hashKey(rows, r, key, intKey, build->probeFactor))) out.rows[0].push_back(r);
+        }
+        out.count = out.rows[0].size();
+        checked += batch.count;
+        passed += out.count;
+        disabled = checked >= BLOOM_SAMPLE_ROWS && passed * 4 > checked * 3;
+        emit(out);
+    }
+
+    string planDetail() const override {
+        if(!pipeline.analyze()) return detail;
+        if(build->spilled()) return detail + ", not used (hash table spilled)";
+        string result = detail + ", " + to_string(build->bloom.bitCount()) + " bits";
+        if(disabled) result += ", stopped after " + to_string(checked) + " rows (" + to_string(passed) + " passed)";
+        return result;
+    }
+
+private:
+    const HashBuildOp* build;
+    size_t key;
+    bool intKey;
+    bool disabled = false;
+    size_t checked = 0, passed = 0;
+    Batch out;
+};
+
+//哈希连接: 上游的批逐个元组查新表的哈希表, 匹配的元组加上新表的行号后推出
+//第一步需要reorder时(哈希表建在FROM中靠前的表上), 记下匹配的探测行(页存储表复制用到的列),
+//全部探测完后按建表侧的行序稳定排序再推出, 输出顺序与嵌套循环相同
+//复制的行和排序缓冲计入语句的工作内存; 排序缓冲超出预算时排好序写成一个有序段, 最后与其余的段按建表侧的行序归并
+//哈希表落盘时, 上游的元组也按连接列的哈希写入各分区, 全部到齐后逐个分区连接, 结果连同排序键写成有序段再归并;
+//排序键reorder时为建表侧的到达序号, 否则为探测元组的到达序号, 输出顺序与不落盘时相同
+class HashJoinOp : public Operator {
+public:
+    HashJoinOp(Pipeline& pipeline, const JoinSpec& spec, size_t step, HashBuildOp* build, const string& detail)
+        : Operator(pipeline, Phase::JOIN, "Hash Join", detail), spec(spec), step(spec.steps[step]), width(step + 1), build(build),
+          probeRows(pipeline.db.currentDatabase->schema(spec.tables[spec.order[0]]).types, false),
+          memory(pipeline.db.memory, "hash join with " + spec.tables[spec.steps[step].table]) {
+        const JoinKey& key = spec.keys[this->step.keys[0]];
+        bool newOnLeft = key.left == this->step.table;
+        probeTable = newOnLeft ? key.right : key.left;
+        probeKey = newOnLeft ? key.rightCol : key.leftCol;
+    }
+
+protected:
+    void process(Batch& batch) override {
+        if(build->spilled()) {
+            spillProbe(batch);
+            return;
+        }
+        probe(batch);
+    }
+
+    void flush() override {
+        if(build->spilled()) {
+            joinPartitions();
+        } else if(!runs.empty()) {
+            spillSorted();
+        }
+        if(!runs.empty()) {
+            mergeRuns();
+        } else if(step.reorder) {
+            sortPairs();
+            out.reset({probeStore, &build->store()}, true);
+            for(const auto& p : pairs) {
+                out.rows[0].push_back(p.second);
+                out.rows[1].push_back(build->rowId(p.first));
+            }
+            out.count = pairs.size();
+            emitChunked(out);
+        }
+        // 下游每批推来时就处理完, 不会再读这一步的哈希表和缓冲
+        build->release();
+        pairs = vector<pair<size_t,size_t>>();
+        probeRows = RowStore(pipeline.db.currentDatabase->schema(spec.tables[spec.order[0]]).types, false);
+        for(auto& ids : out.rows) ids = vector<size_t>();
+        memory.set(workingBytes());
+    }
+
+    string planDetail() const override {
+        if(!pipeline.analyze()) return detail;
+        string result = detail;
+        if(build->spilled()) result += ", grace hash join: " + to_string(probed) + " probe rows spilled to " + to_string(SPILL_PARTITIONS) + " partitions";
+        if(resplit) result += ", " + to_string(resplit) + " partitions split again";
+        if(overBudget) result += ", sort buffer over memory budget: " + to_string(overBudget) + " sorted runs written";
+        return result;
+    }
+
+private:
+    // 用当前的哈希表探测一批: 不reorder时结果每攒够BLOCK_ROWS个推出一次, 否则记入pairs
+    void probe(Batch& batch) {
+        const RowStore& hashed = build->store();
+        size_t probePos = spec.position[probeTable];
+        const RowStore& probe = *batch.tables[probePos];
+        if(!step.reorder) {
+            tables = batch.tables;
+            tables.push_back(&hashed);
+            out.reset(tables, batch.stable);
+        } else if(batch.stable) {
+            probeStore = &probe;
+        }
+        for(size_t k = 0; k < batch.count; ++k) {
+            size_t j = batch.row(probePos, k), copied = HashBuildOp::NO_ROW;
+            for(size_t b = build->find(probe, j, probeKey); b != HashBuildOp::NO_ROW; b = build->nextRow[b]) {
+                // 其余ON条件(两张表之间有多个等值条件时)
+                auto locate = [&](size_t t) {
+                    if(t == step.table) return RowRef(&hashed, build->rowId(b));
+                    size_t p = spec.position[t];
+                    return RowRef(batch.tables[p], batch.row(p, k));
+                };
+                if(step.keys.size() > 1 && !keysMatch(spec, step.keys, 1, locate)) {
+                    continue;
+                }
+                if(!step.reorder) {
+                    for(size_t t = 0; t < batch.tables.size(); ++t) {
+                        out.rows[t].push_back(batch.row(t, k));
+                    }
+                    out.rows.back().push_back(build->rowId(b));
+                    if(out.rows[0].size() >= BLOCK_ROWS) drain();
+                    continue;
+                }
+                if(batch.stable) {
+                    pairs.push_back({b, j});
+                    continue;
+                }
+                if(copied == HashBuildOp::NO_ROW) {
+                    copied = probeRows.size();
+                    probeRows.appendFrom(probe, j, spec.columns[spec.order[0]]);
+                }
+                pairs.push_back({b, copied});
+            }
+        }
+        if(!step.reorder) drain();
+        if(step.reorder && !memory.trySet(workingBytes()) && !pairs.empty()) {
+            spillSorted();
+            overBudget++;
+        }
+        memory.set(workingBytes());
+    }
+
+    size_t workingBytes() const {
+        size_t bytes = probeRows.memoryBytes() + pairs.capacity() * sizeof(pairs[0]);
+        for(const auto& ids : out.rows) bytes += ids.capacity() * sizeof(size_t);
+        for(const auto& stored : loaded) bytes += stored.memoryBytes();
+        return bytes;
+    }
+
+    // 推出out中攒下的结果; 逐个分区连接时写入这个分区的有序段, 排序键为探测元组的到达序号
+    void drain() {
+        out.count = out.rows[0].size();
+        if(partitionRun) {
+            for(size_t i = 0; i < out.count; ++i) {
+                writeTuple(*partitionRun, probeSeq[out.rows[0][i]], out.tables, [&](size_t t) { return out.rows[t][i]; });
+            }
+        } else {
+            emit(out);
+        }
+        for(auto& ids : out.rows) ids.clear();
+        out.count = 0;
+    }
+
+    void sortPairs() {
+        stable_sort(pairs.begin(), pairs.end(), [](const pair<size_t,size_t>& a, const pair<size_t,size_t>& b) { return a.first < b.first; });
+    }
+
+    // reorder的排序缓冲写成一个有序段后清空; 排序键为建表侧的到达序号(落盘连接时由分区中的编号换算)
+    void spillSorted() {
+        if(pairs.empty()) return;
+        sortPairs();
+        compactRuns();
+        runs.push_back(make_unique<SpillFile>(pipeline.db.profiler));
+        vector<const RowStore*> joined{probeStore, &build->store()};
+        for(const auto& m : pairs) {
+            uint64_t sortKey = buildSeq.empty() ? m.first : buildSeq[m.first];
+            writeTuple(*runs.back(), sortKey, joined, [&](size_t t) { return t == 0 ? m.second : build->rowId(m.first); });
+        }
+        pairs = vector<pair<size_t,size_t>>();
+        probeRows = RowStore(pipeline.db.currentDatabase->schema(spec.tables[spec.order[0]]).types, false);
+    }
+
+    // 哈希表已落盘: 上游的元组按探测列的哈希写入对应的分区
+    void spillProbe(Batch& batch) {
+        if(probeFiles.empty()) {
+            for(size_t p = 0; p < SPILL_PARTITIONS; ++p) probeFiles.push_back(make_unique<SpillFile>(pipeline.db.profiler));
+        }
+        size_t probePos = spec.position[probeTable];
+        const RowStore& probe = *batch.tables[probePos];
+        for(size_t k = 0; k < batch.count; ++k) {
+            uint64_t hash = BloomFilter::hashKey(probe, batch.row(probePos, k), probeKey, build->intKey, build->probeFactor);
+            writeTuple(*probeFiles[HashBuildOp::partitionOf(hash)], probed++, batch.tables, [&](size_t t) { return batch.row(t, k); });
+        }
+    }
+
+    // 逐个分区: 读回建表侧建哈希表, 读回探测侧的元组每BLOCK_ROWS个一批探测, 结果写成这个分区的有序段
+    // 先读入探测侧的第一批并登记探测所需的内存, 这一批或建表侧的分区在剩下的预算中装不下时两侧都按下一层的哈希再分,
+    // 子分区排到待连接的最前面; 再分的层数到了上限, 或者装不下的建表侧分区中连接列都相同时语句报错
+    // 有序段按排序键归并, 分区的连接次序不影响输出顺序
+    void joinPartitions() {
+        uint64_t bytes = 0;
+        for(const auto& file : probeFiles) bytes += file->bytes;
+        loaded = storesFor(width);
+        vector<const RowStore*> loadedTables;
+        for(const auto& stored : loaded) loadedTables.push_back(&stored);
+        struct Part {
+            SpillFile* build;
+            SpillFile* probe;
+            size_t depth;
+            unique_ptr<SpillFile> ownBuild, ownProbe;  // 再分出的子分区由自己持有, 连接完或再分后释放
+        };
+        vector<Part> pending;  // 待连接的分区, 从末尾取
+        for(size_t p = SPILL_PARTITIONS; p-- > 0 && !probeFiles.empty();) pending.push_back({&build->partition(p), probeFiles[p].get(), 0, nullptr, nullptr});
+        Batch in;
+        while(!pending.empty()) {
+            Part part = move(pending.back());
+            pending.pop_back();
+            if(part.build->bytes == 0 || part.probe->bytes == 0) continue;
+            SpillFile& input = *part.probe;
+            input.startReading();
+            bool more = readBlock(input);
+            size_t probing = workingBytes() + probeSeq.size() * (width + 1) * sizeof(size_t);  // 加上这一批结果的行号
+            bool probeFits = memory.trySet(probing);
+            if(!probeFits || !build->loadPartition(*part.build, buildSeq)) {
+                if(part.depth == MAX_SPILL_DEPTH) {
+                    if(!probeFits) memory.set(probing);
+                    build->fail(" after splitting a partition " + to_string(MAX_SPILL_DEPTH) + " times");
+                }
+                bool singleKey = false;
+                auto builds = build->repartition(*part.build, part.depth + 1, singleKey);
+                if(probeFits && singleKey) build->fail(" for rows with a single join key");
+                auto probes = repartitionProbe(*part.probe, part.depth + 1);
+                for(size_t p = SPILL_PARTITIONS; p-- > 0;) {
+                    bytes += builds[p]->bytes + probes[p]->bytes;
+                    if(builds[p]->bytes && probes[p]->bytes) {
+                        pending.push_back({builds[p].get(), probes[p].get(), part.depth + 1, move(builds[p]), move(probes[p])});
+                    }
+                }
+                // 放开按大分区分配的缓冲, 子分区按自己的大小重新登记
+                vector<RowStore> fresh = storesFor(width);
+                for(size_t t = 0; t < width; ++t) loaded[t] = move(fresh[t]);
+                for(auto& ids : out.rows) ids = vector<size_t>();
+                memory.set(workingBytes());
+                resplit++;
+                continue;
+            }
+            if(!step.reorder) {
+                compactRuns();
+                runs.push_back(make_unique<SpillFile>(pipeline.db.profiler));
+                partitionRun = runs.back().get();
+            }
+            while(true) {
+                in.reset(loadedTables, false);
+                for(auto& ids : in.rows) {
+                    for(size_t k = 0; k < probeSeq.size(); ++k) ids.push_back(k);
+                }
+                in.count = probeSeq.size();
+                probe(in);
+                if(!more) break;
+                more = readBlock(input);
+            }
+            // 排序缓冲中的行号指向这个分区的哈希表, 换分区之前写出
+            if(step.reorder) spillSorted();
+        }
+        for(const auto& run : runs) bytes += run->bytes;
+        pipeline.db.memory.noteSpill(bytes + compactedBytes);
+        partitionRun = nullptr;
+        build->release();
+        probeFiles.clear();
+        loaded.clear();
+        buildSeq.clear();
+        memory.set(workingBytes());
+    }
+
+    // 读回探测侧的下一批(至多BLOCK_ROWS个元组)到loaded, 排序键记入probeSeq; 文件读完时返回false
+    bool readBlock(SpillFile& input) {
+        for(auto& stored : loaded) stored.clear();
+        probeSeq.clear();
+        while(probeSeq.size() < BLOCK_ROWS) {
+            if(!input.read(record)) return false;
+            probeSeq.push_back(readTuple(record, loaded));
+        }
+        return true;
+    }
+
+    // 探测侧的一个分区按第depth层的哈希再分, 与建表侧的再分一致; 元组原样写入, 各子分区中仍按到达顺序
+    vector<unique_ptr<SpillFile>> repartitionProbe(SpillFile& file, size_t depth) {
+        vector<unique_ptr<SpillFile>> parts;
+        for(size_t p = 0; p < SPILL_PARTITIONS; ++p) parts.push_back(make_unique<SpillFile>(pipeline.db.profiler));
+        size_t probePos = spec.position[probeTable];
+        file.startReading();
+        while(file.read(record)) {
+            for(auto& stored : loaded) stored.clear();
+            readTuple(record, loaded);
+            uint64_t hash = BloomFilter::hashKey(loaded[probePos], 0, probeKey, build->intKey, build->probeFactor);
+            parts[HashBuildOp::partitionOf(hash, depth)]->write(record);
+        }
+        for(auto& stored : loaded) stored.clear();
+        return parts;
+    }
+
+    // 有序段达到MERGE_FAN_IN个时先归并成一段, 放在最前面(键相同时它的元组仍然先取)
+    void compactRuns() {
+        if(runs.size() < MERGE_FAN_IN) return;
+        auto merged = make_unique<SpillFile>(pipeline.db.profiler);
+        mergeRuns(merged.get());
+        compactedBytes += merged->bytes;
+        runs.push_back(move(merged));
+    }
+
+    // 各有序段按排序键归并, 键相同时先取先写出的段; into为空时攒够BLOCK_ROWS个元组推出一批, 批中的表只在推出期间有效,
+    // 否则元组原样写入into
+    void mergeRuns(SpillFile* into = nullptr) {
+        vector<RowStore> merged = storesFor(width + 1);
+        vector<const RowStore*> mergedTables;
+        for(const auto& stored : merged) mergedTables.push_back(&stored);
+        vector<string> heads(runs.size());
+        vector<uint64_t> keys(runs.size());
+        vector<bool> live(runs.size());
+        auto advance = [&](size_t r) {
+            live[r] = runs[r]->read(heads[r]);
+            if(live[r]) memcpy(&keys[r], heads[r].data(), 8);
+        };
+        for(size_t r = 0; r < runs.size(); ++r) {
+            runs[r]->startReading();
+            advance(r);
+        }
+        size_t count = 0;
+        auto push = [&] {
+            out.reset(mergedTables, false);
+            for(auto& ids : out.rows) {
+                for(size_t k = 0; k < count; ++k) ids.push_back(k);
+            }
+            out.count = count;
+            emit(out);
+            for(auto& stored : merged) stored.clear();
+            count = 0;
+        };
+        while(true) {
+            size_t next = runs.size();
+            for(size_t r = 0; r < runs.size(); ++r) {
+                if(live[r] && (next == runs.size() || keys[r] < keys[next])) next = r;
+            }
+            if(next == runs.size()) break;
+            if(into) {
+                into->write(heads[next]);
+            } else {
+                readTuple(heads[next], merged);
+                if(++count == BLOCK_ROWS) push();
+            }
+            advance(next);
+        }
+        if(count) push();
+        runs.clear();
+    }
+
+    // 落盘的元组: 8字节排序键, 然后依次是每个位置上的表用到的列(RowStore::encodeTo的格式)
+    template<typename RowOf>
+    void writeTuple(SpillFile& file, uint64_t sortKey, const vector<const RowStore*>& from, RowOf rowOf) {
+        record.assign(reinterpret_cast<const char*>(&sortKey), 8);
+        for(size_t t = 0; t < from.size(); ++t) from[t]->encodeTo(record, rowOf(t), spec.columns[spec.order[t]]);
+        file.write(record);
+    }
+
+    // 读回一个元组, 第t个位置的行追加到stores[t]; 返回排序键
+    uint64_t readTuple(const string& text, vector<RowStore>& stores) {
+        uint64_t sortKey;
+        memcpy(&sortKey, text.data(), 8);
+        const char* in = text.data() + 8;
+        for(size_t t = 0; t < stores.size(); ++t) in = stores[t].appendEncoded(in, spec.columns[spec.order[t]]);
+        return sortKey;
+    }
+
+    // 中间结果前n个位置上的表各一个空的行存储
+    vector<RowStore> storesFor(size_t n) const {
+        vector<RowStore> stores;
+        for(size_t t = 0; t < n; ++t) stores.emplace_back(pipeline.db.currentDatabase->schema(spec.tables[spec.order[t]]).types, false);
+        return stores;
+    }
+
+    const JoinSpec& spec;
+    const JoinStep& step;
+    size_t width;  // 上游元组中的表数
+    HashBuildOp* build;
+    size_t probeTable = 0, probeKey = TableSchema::npos;  // 哈希键在中间结果一侧的表和列
+    RowStore probeRows;
+    const RowStore* probeStore = &probeRows;  // 内存表为表本身, 否则为probeRows
+    vector<pair<size_t,size_t>> pairs;  // reorder时: (建表侧的编号, probeStore中的行)
+    vector<const RowStore*> tables;
+    Batch out;
+    MemoryReservation memory;
+    vector<unique_ptr<SpillFile>> runs;  // 待归并的有序段, 每个元组带8字节排序键
+    size_t overBudget = 0;  // 排序缓冲超出预算而写出的有序段数
+    size_t resplit = 0;     // 读回超出预算而再分的分区数
+    uint64_t compactedBytes = 0;  // 提前归并写出的字节数
+    vector<unique_ptr<SpillFile>> probeFiles;  // 哈希表落盘后: 每个分区一个临时文件
+    uint64_t probed = 0;  // 已写出的探测元组数
+    // 逐个分区连接时: 读回的探测元组(每个位置一个行存储)和它们的到达序号, 哈希表中各行在建表侧的到达序号, 当前分区的有序段
+    vector<RowStore> loaded;
+    vector<uint64_t> probeSeq, buildSeq;
+    SpillFile* partitionRun = nullptr;
+    string record;
+};
+
+//连接后的过滤: WHERE不能拆到各表(有OR)时, 在完整的元组上逐个求值
+class JoinFilterOp : public Operator {
+public:
+    JoinFilterOp(Pipeline& pipeline, const JoinSpec& spec, const string& detail)
+        : Operator(pipeline, Phase::FILTER, "Filter", detail), spec(spec) {}
+
+protected:
+    void process(Batch& batch) override {
+        out.reset(batch.tables, batch.stable);
+        for(size_t k = 0; k < batch.count; ++k) {
+            auto locate = [&](size_t t) {
+                size_t p = spec.position[t];
+                return RowRef(batch.tables[p], batch.row(p, k));
+            };
+            if(!pipeline.db.joinMatches(spec, locate)) continue;
+            for(size_t t = 0; t < batch.tables.size(); ++t) {
+                out.rows[t].push_back(batch.row(t, k));
+            }
+        }
+        out.count = out.rows[0].size();
+        emit(out);
+    }
+
+private:
+    const JoinSpec& spec;
+    Batch out;
+};
+
+//结果缓存的键(数据库, 规范化SQL)和用到的各表当前的版本号; 缓存关闭或有表不存在时返回false
+bool cacheKey(const string& sql, const vector<string>& tables, string& key, vector<uint64_t>& versions)
+{
+    if(!resultCache.enabled() || !currentDatabase) {
+        return false;
+    }
+    versions.clear();
+    for(const auto& table : tables) {
+        uint64_t version = tableVersion(table);
+        if(version == 0 || currentDatabase->tables.find(table) == currentDatabase->tables.end()) {
+            return false;
+        }
+        versions.push_back(version);
+    }
+    key = currentDatabase->name + "\n" + normalizeSql(sql);
+    return true;
+}
+
+//输出一条缓存的结果: 分隔行, 再原样写出列名行和结果行
+void writeCached(ostream& file, const ResultCache::Entry& entry)
+{
+    if(isprint)
+    {
+        file<<"---"<<endl;
+    }
+    else
+    {
+        isprint=true;
+    }
+    file << entry.text;
+    profiler.addEmitted(entry.rows);
+}
+
+//经结果缓存执行一条查询: 用到的表都存在时按(数据库, 规范化SQL)查找, 各表版本都没变就直接输出缓存的结果
+//未命中时run()照常执行, 输出同时记下来, 完整执行结束(没有中途出错返回)才放入缓存
+template<typename Run>
+void cachedQuery(const string& sql, const vector<string>& tables, const string& outputFile, Run run)
+{
+    string key;
+    vector<uint64_t> versions;
+    if(!cacheKey(sql, tables, key, versions)) {
+        run();  // 表不存在时照常报错
+        return;
+    }
+    ResultCache::Entry entry;
+    if(resultCache.find(key, versions, entry)) {
+        auto file = openOutput(outputFile);
+        if(!file) {
+            return;
+        }
+        writeCached(*file, entry);
+        profiler.addWritten(entry.text.size());
+        return;
+    }
+    ResultCache::Capture captured;
+    capture = &captured;
+    try {
+        run();
+    } catch(...) {
+        capture = nullptr;
+        throw;
+    }
+    capture = nullptr;
+    if(captured.complete) {
+        resultCache.put({key, versions, move(captured.text), captured.rows});
+    }
+}
+
+//一条SELECT在扫描之后的部分: Filter(有WHERE时) -> Project -> Output, 返回汇点, head为接在扫描后的第一个算子
+//file非空时先写分隔行和列名行; 列名不存在时报错并返回nullptr(列名行已经写出)
+//where为编译好的WHERE, 须活到扫描结束; decode中加上这条查询要解码的列
+Operator* selectBranch(Pipeline& pipeline, const string& tableName, const vector<string>& columnNames, const vector<string>& conditions,
+                       ostream* file, ResultCache::Capture* capture, const string& outputFile, ConditionSet& where, vector<bool>& decode, Operator*& head)
+{
+    if (file) {
+        if(isprint)
+        {
+            *file<<"---"<<endl;
+        }
+        else
+        {
+            isprint=true;
+        }
+
+        string header;
+        for(const auto& col:columnNames)
+        {
+            header+=col;
+            if(col!=columnNames.back())
+            {
+                header+=",";
+            }
+        }
+        header+="\n";
+        *file<<header;
+        if(capture) capture->text += header;
+    }
+
+    const auto& schema = currentDatabase->schema(tableName);
+
+    vector<size_t> colIndices;
+    if (columnNames.size() == 1 && columnNames[0] == "*") {
+        for (size_t i = 0; i < schema.size(); ++i) {
+            colIndices.push_back(i);
+        }
+    } else {
+        for (const auto& colName : columnNames) {
+            size_t index = schema.indexOf(colName);
+            if (index != TableSchema::npos) {
+                colIndices.push_back(index);
+            } else {
+                cerr << "Column " << colName << " does not exist in table " << tableName << endl;
+                return nullptr;
+            }
+        }
+    }
+    where = compileConditions(tableName, conditions);
+
+    string projected;
+    vector<pair<size_t,size_t>> projection;
+    for (const auto& col : columnNames) projected += (projected.empty() ? "" : ", ") + col;
+    for (size_t index : colIndices) projection.push_back({0, index});
+    for (size_t index : colIndices) decode[index] = true;
+    for (const auto& cond : where.conds) {
+        if (cond.index != TableSchema::npos) decode[cond.index] = true;
+    }
+    Operator* output;
+    if (collect) {
+        collect->names.clear();
+        collect->types.clear();
+        for (size_t index : colIndices) {
+            collect->names.push_back(schema.columns[index].name);
+            collect->types.push_back(schema.types[index]);
+        }
+        collect->rows = RowStore(collect->types, false);
+        output = pipeline.add<CollectOp>(projection, collect->rows, projected);
+        head = output;
+    } else {
+        Operator* project = pipeline.add<ProjectOp>(projection, projected);
+        output = pipeline.add<OutputOp>(file, outputFile, capture);
+        Pipeline::chain(project, output);
+        head = project;
+    }
+    if (!where.empty()) {
+        Operator* filter = pipeline.add<FilterOp>(where, conditions);
+        Pipeline::chain(filter, head);
+        head = filter;
+    }
+    return output;
+}
+
+void select_to_file(const string& tableName, const vector<string>& columnNames, const vector<string>& conditions, const string& outputFile, QueryPlan* plan = nullptr)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if (!currentDatabase) {
+        cerr << "No database selected" << endl;
+        return;
+    }
+
+    if (currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
+        cerr << "Table " << tableName << " does not exist" << endl;
+        return;
+    }
+
+    // EXPLAIN不写结果行, 计划在语句结束时统一输出; 库接口收集结果时也不写
+    bool emitRows = plan == nullptr && !collect;
+    unique_ptr<ostream> file;
+    streamoff outputStart = 0;
+    if (emitRows) {
+        // 使用追加模式打开文件
+        file = openOutput(outputFile);
+        if (!file) {
+            return;
+        }
+        outputStart = file->tellp();
+    }
+
+    // 流水线: Scan -> Filter(有WHERE时) -> Project -> Output
+    ConditionSet where;
+    vector<bool> decode(currentDatabase->schema(tableName).size(), false);
+    Pipeline pipeline(*this, plan);
+    Operator* head = nullptr;
+    Operator* output = selectBranch(pipeline, tableName, columnNames, conditions, file.get(), capture, outputFile, where, decode, head);
+    if (!output) {
+        return;
+    }
+    ScanOp* scan = pipeline.add<ScanOp>(tableName, &where, decode);
+    Pipeline::chain(scan, head);
+
+    if (!plan || plan->analyze) {
+        scan->run();
+        scan->end();
+    }
+    if (plan) {
+        output->describe(*plan, 0);
+        return;
+    }
+    if (!file) {
+        return;
+    }
+    profiler.addWritten(static_cast<uint64_t>(file->tellp() - outputStart));
+    file.reset();
+    if(capture) capture->complete = true;
+}
+
+//共享扫描: 同一张表上连续的几条SELECT只扫描一遍, 每一批依次交给各条查询的 Filter -> Project -> Output
+//第一条参与扫描的查询直接写结果文件, 之后的先写到内存, 扫描结束后按语句顺序追加
+//结果缓存命中的查询不参与扫描, 与组内前面某条查询的缓存键相同的查询直接复用它的结果
+//WHERE编译出错的查询按自己的行号报错, 不参与扫描; 扫描中途出错时抛出SharedScanError, 由调用者逐条执行还没写出的语句
+void select_shared(const string& tableName, const vector<SelectQuery>& queries, const string& outputFile)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    auto output = openOutput(outputFile);
+    if (!output) {
+        return;
+    }
+    ostream& file = *output;
+    streamoff outputStart = file.tellp();
+
+    size_t n = queries.size();
+    vector<ostringstream> sections(n);
+    vector<ResultCache::Capture> captures(n);
+    vector<string> keys(n);
+    vector<vector<uint64_t>> versions(n);
+    vector<bool> cached(n, false), scanned(n, false);
+    vector<size_t> sameAs(n, n);
+    unordered_map<string, size_t> firstWithKey;
+    vector<ConditionSet> wheres(n);
+    vector<const ConditionSet*> scanWheres;
+    vector<bool> decode(currentDatabase->schema(tableName).size(), false);
+
+    Pipeline pipeline(*this, nullptr);
+    TeeOp* tee = pipeline.add<TeeOp>();
+    bool streaming = false;  // 已经有查询直接写文件, 之后的都要先写到内存
+    size_t first = n;        // 直接写文件的查询
+    for (size_t i = 0; i < n; ++i) {
+        ostream& out = streaming ? static_cast<ostream&>(sections[i]) : file;
+        cached[i] = cacheKey(queries[i].sql, {tableName}, keys[i], versions[i]);
+        if (cached[i]) {
+            ResultCache::Entry entry;
+            if (resultCache.find(keys[i], versions[i], entry)) {
+                writeCached(out, entry);
+                cached[i] = false;
+                continue;
+            }
+            auto same = firstWithKey.find(keys[i]);
+            if (same != firstWithKey.end()) {
+                if(isprint)
+                {
+                    out<<"---"<<endl;
+                }
+                else
+                {
+                    isprint=true;
+                }
+                sameAs[i] = same->second;
+                cached[i] = false;
+                continue;
+            }
+        }
+        Operator* head = nullptr;
+        try {
+            if (!selectBranch(pipeline, tableName, queries[i].columns, queries[i].conditions, &out, cached[i] ? &captures[i] : nullptr, outputFile, wheres[i], decode, head)) {
+                continue;
+            }
+        } catch (const exception& e) {
+            cerr << "Error at line " << queries[i].line << ": " << e.what() << endl;
+            cerr << "Command: " << queries[i].sql << endl;
+            continue;
+        }
+        if (!streaming) first = i;
+        tee->add(head);
+        scanWheres.push_back(&wheres[i]);
+        scanned[i] = true;
+        streaming = true;
+        if (cached[i]) firstWithKey[keys[i]] = i;
+    }
+
+    if (!scanWheres.empty()) {
+        ScanOp* scan = pipeline.add<ScanOp>(tableName, scanWheres, decode);
+        Pipeline::chain(scan, tee);
+        tee->source = scan;
+        try {
+            scan->run();
+            scan->end();
+        } catch (const exception& e) {
+            // 直接写文件的查询已写出部分结果, 和单独执行时一样算它出错; 内存中的结果丢掉, 之后的语句重新执行
+            profiler.addWritten(static_cast<uint64_t>(file.tellp() - outputStart));
+            throw SharedScanError(e.what(), first, first + 1);
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (sameAs[i] < n) {
+            sections[i] << captures[sameAs[i]].text;
+            profiler.addEmitted(captures[sameAs[i]].rows);
+        }
+        file << sections[i].str();
+    }
+    profiler.addWritten(static_cast<uint64_t>(file.tellp() - outputStart));
+    output.reset();
+    for (size_t i = 0; i < n; ++i) {
+        if (cached[i] && scanned[i]) {
+            resultCache.put({keys[i], versions[i], move(captures[i].text), captures[i].rows});
+        }
+    }
+}
+
+//INNER JOIN链: tables为FROM和各INNER JOIN的表, conditions前2*(表数-1)项依次是每个ON的两边, 其后是WHERE
+void inner_join_file(const vector<string>& tables, const vector<string>& columnNames, const vector<string>& conditions, const string& outputFile, QueryPlan* plan = nullptr)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(!currentDatabase) {
+        cerr << "No database selected" << endl;
+        return;
+    }
+
+    for(const auto& tableName : tables) {
+        if(currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
+            cerr << "Table does not exist" << endl;
+            return;
+        }
+    }
+    size_t joins = tables.size() - 1;
+    if(tables.size() < 2 || conditions.size() < 2 * joins) {
+        cerr << "Invalid INNER JOIN" << endl;
+        return;
+    }
+
+    // EXPLAIN不写结果行, 计划在语句结束时统一输出; 库接口收集结果时也不写
+    bool emitRows = plan == nullptr && !collect;
+    unique_ptr<ostream> file;
+    streamoff outputStart = 0;
+    if(emitRows) {
+        // 使用追加模式
+        file = openOutput(outputFile);
+        if(!file) {
+            return;
+        }
+        outputStart = file->tellp();
+
+        if(isprint)
+        {
+            *file<<"---"<<endl;
+        }
+        else
+        {
+            isprint=true;
+        }
+    }
+
+    // 列名
+    vector<pair<string,string>> join_columns;
+    //分离列名
+    vector<string> where= vector<string>(conditions.begin() + 2 * joins, conditions.end());
+
+    for(const auto& column : columnNames) {
+        join_columns.push_back(splitQualified(column));
+    }
+
+    // 表名 -> 序号; 限定名不是查询中的表时归到最后一张表(两表连接时即table2), 自连接时取第一次出现
+    auto tableIndex = [&](const string& name) {
+        auto it = find(tables.begin(), tables.end(), name);
+        return it == tables.end() ? joins : static_cast<size_t>(it - tables.begin());
+    };
+
+    // 连接列、输出列和WHERE条件在扫描前一次性解析为(表序号, 列序号)
+    JoinSpec spec;
+    spec.tables = tables;
+    for(size_t k = 0; k < joins; ++k) {
+        // 第k个ON只能引用前k+2张表; 在其中从后往前找限定名, 找不到时按位置取第k和第k+1张表
+        auto resolve = [&](const string& name, size_t fallback, size_t avoid) {
+            for(size_t t = k + 2; t-- > 0;) {
+                if(tables[t] == name && t != avoid) return t;
+            }
+            return fallback;
+        };
+        auto left = splitQualified(conditions[2 * k]);
+        auto right = splitQualified(conditions[2 * k + 1]);
+        JoinKey key;
+        key.right = resolve(right.first, k + 1, TableSchema::npos);
+        key.left = resolve(left.first, k, key.right);
+        const auto& leftSchema = currentDatabase->schema(tables[key.left]);
+        const auto& rightSchema = currentDatabase->schema(tables[key.right]);
+        key.leftCol = leftSchema.indexOf(left.second);
+        key.rightCol = rightSchema.indexOf(right.second);
+        // 两边都是INTEGER或DECIMAL时比较内联整数, 小数位数少的一边乘以10^Δ; 都不是时比较文本
+        key.intKey = key.known() && integralType(leftSchema.types[key.leftCol]) && integralType(rightSchema.types[key.rightCol]);
+        if(key.intKey) {
+            int leftScale = decimalScale(leftSchema.types[key.leftCol]), rightScale = decimalScale(rightSchema.types[key.rightCol]);
+            key.leftFactor = pow10i(max(rightScale - leftScale, 0));
+            key.rightFactor = pow10i(max(leftScale - rightScale, 0));
+        }
+        key.textKey = key.known() && !integralType(leftSchema.types[key.leftCol]) && !integralType(rightSchema.types[key.rightCol]);
+        key.text = conditions[2 * k] + " = " + conditions[2 * k + 1];
+        spec.keys.push_back(key);
+    }
+
+    for(const auto& col : join_columns) {
+        size_t t = tableIndex(col.first);
+        spec.projection.push_back({t, currentDatabase->schema(tables[t]).indexOf(col.second)});
+    }
+
+    // WHERE: 每个条件形如 表.列 运算符 值, 两个条件之间为AND/OR
+    for(size_t k = 0; k + 2 < where.size(); k += 4) {
+        auto target = splitQualified(where[k]);
+        size_t t = tableIndex(target.first);
+        spec.where.push_back({t, resolveCondition(currentDatabase->schema(tables[t]), target.second, where[k + 1], where[k + 2])});
+        if(k + 3 < where.size()) {
+            spec.andOr = where[k + 3];
+        }
+    }
+
+    // 每张表用到的列: 扫描页存储表时只解码这些列, 连接复制行时只复制这些列, 输出列在最后按行号取
+    spec.columns.resize(tables.size());
+    auto use = [&](size_t t, size_t col) {
+        auto& cols = spec.columns[t];
+        if(col != TableSchema::npos && find(cols.begin(), cols.end(), col) == cols.end()) cols.push_back(col);
+    };
+    for(const auto& key : spec.keys) {
+        use(key.left, key.leftCol);
+        use(key.right, key.rightCol);
+    }
+    for(const auto& col : spec.projection) use(col.first, col.second);
+    for(const auto& c : spec.where) use(c.first, c.second.index);
+
+    // 只由AND连接(或只有一个)的条件可以拆到各表: 跳过不可能匹配的块, 在连接前过滤
+    spec.pushdown = spec.andOr.empty() || (spec.andOr == "AND" && spec.where.size() > 1);
+    spec.prune.resize(tables.size());
+    if(spec.pushdown) {
+        for(const auto& c : spec.where) {
+            ConditionSet& side = spec.prune[c.first];
+            side.conds.push_back(c.second);
+            if(side.conds.size() > 1) side.logicalOp = "AND";
+        }
+    }
+
+    // 写入列名
+    if(emitRows) {
+        string header;
+        for(size_t i = 0; i < join_columns.size(); ++i) {
+            header += join_columns[i].first + "." + join_columns[i].second;
+            if(i < join_columns.size() - 1) {
+                header += ",";
+            }
+        }
+        header += "\n";
+        *file << header;
+        if(capture) capture->text += header;
+    }
+
+    planJoin(spec);
+
+    string projected, predicate;
+    for(const auto& column : columnNames) projected += (projected.empty() ? "" : ", ") + column;
+    for(const auto& word : where) predicate += (predicate.empty() ? "" : " ") + word;
+
+    // 一张表的流水线: Scan -> Filter(WHERE下推到这张表时)
+    Pipeline pipeline(*this, plan);
+    auto side = [&](size_t t, const string& role, Operator*& last) {
+        const ConditionSet& prune = spec.prune[t];
+        vector<bool> decode(currentDatabase->schema(tables[t]).size(), false);
+        for(size_t col : spec.columns[t]) decode[col] = true;
+        ScanOp* scan = pipeline.add<ScanOp>(tables[t], &prune, decode, role);
+        last = scan;
+        if(spec.pushdown && !prune.empty()) {
+            vector<string> words;
+            for(size_t k = 0; k + 2 < where.size(); k += 4) {
+                if(tableIndex(splitQualified(where[k]).first) != t) continue;
+                if(!words.empty()) words.push_back("AND");
+                words.insert(words.end(), where.begin() + k, where.begin() + k + 3);
+            }
+            Operator* filter = pipeline.add<FilterOp>(prune, words);
+            Pipeline::chain(last, filter);
+            last = filter;
+        }
+        return scan;
+    };
+
+    // 流水线: 驱动表 -> Bloom Filter -> 每一步的连接 -> Filter(WHERE不能下推时) -> Project -> Output
+    // 哈希连接的建表侧各自是一条 Scan -> Hash 的流水线, 在驱动表之前执行
+    vector<ScanOp*> sources;
+    vector<HashBuildOp*> hashes(spec.steps.size(), nullptr);
+    for(size_t s = 0; s < spec.steps.size(); ++s) {
+        const JoinStep& step = spec.steps[s];
+        if(!step.hash) continue;
+        Operator* sideLast = nullptr;
+        sources.push_back(side(step.table, " (build)", sideLast));
+        const JoinKey& key = spec.keys[step.keys[0]];
+        size_t col = key.left == step.table ? key.leftCol : key.rightCol;
+        const auto& schema = currentDatabase->schema(tables[step.table]);
+        size_t probeTable = key.left == step.table ? key.right : key.left;
+        hashes[s] = pipeline.add<HashBuildOp>(schema.types, col, key.intKey, key.factor(step.table), key.factor(probeTable), spec.columns[step.table],
+                                              BLOCK_ROWS * (s + 2) * sizeof(size_t),
+                                              "key " + tables[step.table] + "." + schema.names()[col]);
+        Pipeline::chain(sideLast, hashes[s]);
+    }
+
+    // 半连接下推: 哈希键在驱动表一侧的每一步, 驱动表扫描后先用哈希表的Bloom过滤器丢掉不可能匹配的行
+    Operator* last = nullptr;
+    size_t driverTable = spec.order[0];
+    ScanOp* driver = side(driverTable, spec.steps[0].hash ? " (probe)" : " (outer)", last);
+    for(size_t s = 0; s < spec.steps.size(); ++s) {
+        if(!hashes[s]) continue;
+        const JoinKey& key = spec.keys[spec.steps[s].keys[0]];
+        bool newOnLeft = key.left == spec.steps[s].table;
+        if((newOnLeft ? key.right : key.left) != driverTable) continue;
+        size_t col = newOnLeft ? key.rightCol : key.leftCol;
+        string column = tables[driverTable] + "." + currentDatabase->schema(tables[driverTable]).names()[col];
+        string built = tables[spec.steps[s].table] + "." + currentDatabase->schema(tables[spec.steps[s].table]).names()[newOnLeft ? key.leftCol : key.rightCol];
+        Operator* bloom = pipeline.add<BloomFilterOp>(hashes[s], col, key.intKey, column + " in " + built);
+        Pipeline::chain(last, bloom);
+        last = bloom;
+    }
+
+    for(size_t s = 0; s < spec.steps.size(); ++s) {
+        const JoinStep& step = spec.steps[s];
+        ostringstream detail;
+        detail << fixed << setprecision(0);
+        if(step.hash) detail << "build " << tables[step.table] << ", ";
+        for(size_t i = 0; i < step.keys.size(); ++i) {
+            const JoinKey& key = spec.keys[step.keys[i]];
+            detail << (i ? " AND " : "") << key.text;
+            if(i == 0) detail << (key.intKey ? " (integer keys)" : key.textKey ? " (text keys)" : key.known() ? " (mixed types, compared as text)" : " (unknown join column)");
+        }
+        if(step.keys.empty()) detail << "no join condition";
+        detail << ", est. " << step.rowsIn << " x " << step.rows << " rows, cost " << step.cost;
+        if(step.hash) detail << " (nested loop " << step.nestedLoopCost << ")";
+        Operator* join = nullptr;
+        if(step.hash) {
+            join = pipeline.add<HashJoinOp>(spec, s, hashes[s], detail.str());
+            Pipeline::chain(last, join);
+            join->children.push_back(hashes[s]);
+        } else {
+            Operator* sideLast = nullptr;
+            ScanOp* inner = side(step.table, " (inner)", sideLast);
+            auto* nestedLoop = pipeline.add<NestedLoopJoinOp>(spec, s, detail.str());
+            Pipeline::chain(last, nestedLoop);
+            nestedLoop->setInner(inner, sideLast);
+            join = nestedLoop;
+        }
+        last = join;
+    }
+    sources.push_back(driver);
+    if(!spec.pushdown && !spec.where.empty()) {
+        Operator* filter = pipeline.add<JoinFilterOp>(spec, predicate + " [row-at-a-time]");
+        Pipeline::chain(last, filter);
+        last = filter;
+    }
+    vector<pair<size_t,size_t>> projection;
+    for(const auto& col : spec.projection) {
+        projection.push_back({spec.position[col.first], col.second});
+    }
+    Operator* output;
+    if(collect) {
+        collect->names.clear();
+        collect->types.clear();
+        for(size_t i = 0; i < join_columns.size(); ++i) {
+            const auto& col = spec.projection[i];
+            collect->names.push_back(join_columns[i].first + "." + join_columns[i].second);
+            collect->types.push_back(col.second == TableSchema::npos ? "TEXT" : currentDatabase->schema(tables[col.first]).types[col.second]);
+        }
+        collect->rows = RowStore(collect->types, false);
+        output = pipeline.add<CollectOp>(projection, collect->rows, projected);
+        Pipeline::chain(last, output);
+    } else {
+        Operator* project = pipeline.add<ProjectOp>(projection, projected);
+        output = pipeline.add<OutputOp>(file.get(), outputFile, capture);
+        Pipeline::chain(last, project);
+        Pipeline::chain(project, output);
+    }
+
+    if(!plan || plan->analyze) {
+        for(ScanOp* source : sources) {
+            source->run();
+            source->end();
+        }
+    }
+    if(plan) {
+        output->describe(*plan, 0);
+        return;
+    }
+    if(!file) {
+        return;
+    }
+    profiler.addWritten(static_cast<uint64_t>(file->tellp() - outputStart));
+    file.reset();
+    if(capture) capture->complete = true;
+}
+
+//WHERE对一个连接后的元组求值: 一个条件, 或两个条件由AND/OR连接; locate(t)给出表t在元组中的行
+template<typename Locate>
+bool joinMatches(const JoinSpec& spec, Locate locate)
+{
+    if(spec.where.empty()) {
+        return true;
+    }
+    auto test = [&](const pair<size_t,Condition>& c) {
+        RowRef row = locate(c.first);
+        return evaluateCondition(*row.first, row.second, c.second);
+    };
+    if(spec.where.size() > 1) {
+        if(spec.andOr == "AND") return test(spec.where[0]) && test(spec.where[1]);
+        if(spec.andOr == "OR") return test(spec.where[0]) || test(spec.where[1]);
+        return true;
+    }
+    return test(spec.where[0]);
+}
+
+//连接顺序和每一步的算法: 先连接估计结果最小的一对表, 之后每次接入使中间结果最小的、与已连接部分有ON条件的表
+//行数取表的当前行数, 选择率和连接列的不同值个数来自ANALYZE, 没有统计时用默认估计
+void planJoin(JoinSpec& spec)
+{
+    size_t n = spec.tables.size();
+    vector<double> scanned(n), rows(n);
+    for(size_t t = 0; t < n; ++t) {
+        scanned[t] = estimateRows(spec.tables[t]);
+        rows[t] = spec.pushdown ? scanned[t] * estimateSelectivity(spec.prune[t], statsFor(spec.tables[t])) : scanned[t];
+    }
+    auto distinct = [&](const JoinKey& key) {
+        if(!key.known()) return 1.0;
+        return max({1.0, columnDistinct(spec.tables[key.left], key.leftCol, rows[key.left]), columnDistinct(spec.tables[key.right], key.rightCol, rows[key.right])});
+    };
+
+    // 第一对表, 按FROM中的先后为a, b
+    size_t a = 0, b = 1;
+    double best = numeric_limits<double>::max();
+    for(const auto& key : spec.keys) {
+        if(key.left == key.right) continue;
+        double estimate = rows[key.left] * rows[key.right] / distinct(key);
+        if(estimate < best) {
+            best = estimate;
+            a = min(key.left, key.right);
+            b = max(key.left, key.right);
+        }
+    }
+
+    vector<bool> joined(n, false), used(spec.keys.size(), false);
+    // 把表x接到joined上时检查的ON条件: 两边都已接入的条件; 能作哈希键的(连接x和已接入的表)排在最前
+    auto stepKeys = [&](size_t x) {
+        vector<size_t> keys;
+        for(size_t k = 0; k < spec.keys.size(); ++k) {
+            const JoinKey& key = spec.keys[k];
+            bool ready = (joined[key.left] || key.left == x) && (joined[key.right] || key.right == x);
+            if(!used[k] && ready) keys.push_back(k);
+        }
+        stable_partition(keys.begin(), keys.end(), [&](size_t k) {
+            const JoinKey& key = spec.keys[k];
+            return key.hashable() && key.left != key.right && (key.left == x || key.right == x);
+        });
+        return keys;
+    };
+    // 代价: 中间结果(估计outerRows行, 分outerBatches批推来)和表x连接, 在块嵌套循环和建在x上的哈希连接中选
+    // 嵌套循环每批重扫x, 每对行比较一次连接列; outerScan为第一步驱动表的扫描
+    auto costStep = [&](size_t x, const vector<size_t>& keys, double outerScan, double outerBatches, double outerRows) {
+        JoinStep step;
+        step.table = x;
+        step.keys = keys;
+        step.rowsIn = outerRows;
+        step.rows = rows[x];
+        bool connects = !keys.empty() && spec.keys[keys[0]].left != spec.keys[keys[0]].right;
+        step.rowsOut = outerRows * rows[x] / (connects ? distinct(spec.keys[keys[0]]) : 1.0);
+        step.cost = step.nestedLoopCost = outerScan + outerBatches * scanned[x] + outerRows * rows[x] * COST_PAIR;
+        if(connects && spec.keys[keys[0]].hashable()) {
+            double hash = outerScan + scanned[x] + rows[x] * COST_BUILD + outerRows * COST_PROBE;
+            if(hash < step.cost) {
+                step.hash = true;
+                step.cost = hash;
+            }
+        }
+        return step;
+    };
+
+    // 第一步: a为外表/探测侧, 或者哈希表建在a上、探测b后恢复a的顺序
+    joined[a] = true;
+    JoinStep first = costStep(b, stepKeys(b), scanned[a], max(1.0, ceil(scanned[a] / BLOCK_ROWS)), rows[a]);
+    spec.order = {a, b};
+    joined[a] = false;
+    joined[b] = true;
+    vector<size_t> reversedKeys = stepKeys(a);
+    if(!reversedKeys.empty() && spec.keys[reversedKeys[0]].hashable() && spec.keys[reversedKeys[0]].left != spec.keys[reversedKeys[0]].right) {
+        JoinStep reversed = first;
+        reversed.table = a;
+        reversed.keys = reversedKeys;
+        reversed.hash = true;
+        reversed.reorder = true;
+        reversed.rowsIn = rows[b];
+        reversed.rows = rows[a];
+        reversed.cost = scanned[a] + scanned[b] + rows[a] * COST_BUILD + rows[b] * COST_PROBE + first.rowsOut * COST_REORDER;
+        if(reversed.cost < first.cost) {
+            first = reversed;
+            spec.order = {b, a};
+        }
+    }
+    joined[a] = joined[b] = true;
+    for(size_t k : first.keys) used[k] = true;
+    spec.steps.push_back(first);
+
+    // 之后每次接入一张表
+    double current = first.rowsOut, batches = max(1.0, ceil(scanned[spec.order[0]] / BLOCK_ROWS));
+    while(spec.order.size() < n) {
+        JoinStep choice;
+        double smallest = numeric_limits<double>::max();
+        bool connected = false;
+        for(size_t x = 0; x < n; ++x) {
+            if(joined[x]) continue;
+            vector<size_t> keys = stepKeys(x);
+            const JoinKey* key = keys.empty() ? nullptr : &spec.keys[keys[0]];
+            bool connects = key && key->left != key->right && (key->left == x || key->right == x);
+            JoinStep step = costStep(x, keys, 0, batches, current);
+            // 有ON条件相连的表优先, 其次比较连接后的估计行数, 相同时取FROM中靠前的
+            if((connects && !connected) || (connects == connected && step.rowsOut < smallest)) {
+                choice = step;
+                smallest = step.rowsOut;
+                connected = connects;
+            }
+        }
+        joined[choice.table] = true;
+        for(size_t k : choice.keys) used[k] = true;
+        spec.order.push_back(choice.table);
+        spec.steps.push_back(choice);
+        current = choice.rowsOut;
+        batches = max(batches, ceil(current / BLOCK_ROWS));
+    }
+
+    spec.position.assign(n, 0);
+    for(size_t p = 0; p < n; ++p) {
+        spec.position[spec.order[p]] = p;
+    }
+}
+
+//估计表的当前行数: 内存表直接取行数, 页存储表用块统计中的行数, 都没有时用ANALYZE的结果
+double estimateRows(const string& tableName)
+{
+    if(currentDatabase->partitions.count(tableName)) {
+        double rows = 0;
+        for(const auto& part : prunePartitions(tableName, {})) rows += estimateRows(part);
+        return rows;
+    }
+    if(!currentDatabase->pagedTables.count(tableName)) {
+        return static_cast<double>(readTable(tableName).size());
+    }
+    size_t pages = scanBlocks(tableName);
+    auto zones = currentDatabase->pageZones.find(tableName);
+    if(zones != currentDatabase->pageZones.end() && zones->second.size() == pages) {
+        double rows = 0;
+        for(const auto& zone : zones->second) rows += zone.rows;
+        return rows;
+    }
+    const TableStats* stats = statsFor(tableName);
+    return stats ? static_cast<double>(stats->rows) : pages * 50.0;
+}
+
+const TableStats* statsFor(const string& tableName) const
+{
+    auto it = currentDatabase->tableStats.find(tableName);
+    return it == currentDatabase->tableStats.end() ? nullptr : &it->second;
+}
+
+//连接列的不同值个数, 不超过参与连接的行数; 没有统计时按每行不同估计
+double columnDistinct(const string& tableName, size_t col, double rows)
+{
+    const TableStats* stats = statsFor(tableName);
+    if(!stats || col >= stats->cols.size() || stats->cols[col].distinct == 0) {
+        return rows;
+    }
+    return min(rows, static_cast<double>(stats->cols[col].distinct));
+}
+
+//SHOW TABLE STATS [表名]: 每张表每列一行, 再加一行整表合计(列名为*); SHOW MEMORY: 只输出整表合计, 最后一行为全部表的总计
+//内存中的表: 值的字节数按实际内容计, 开销为已分配的内存减去值(文本列的偏移和长度、预留的容量、删除和更新留下的文本、块统计)
+//仍在页文件中的表不占行的内存, 行数取自每页的块统计, 开销为块统计本身
+void show_stats(const string& tableName, bool columns, const string& outputFile)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(!currentDatabase) {
+        cerr << "No database selected" << endl;
+        return;
+    }
+    if(!tableName.empty() && currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
+        cerr << "Table " << tableName << " does not exist" << endl;
+        return;
+    }
+    // 分区表本身没有行, 列出它的各个分区
+    vector<string> names;
+    for(const auto& table : currentDatabase->tables) {
+        const string& name = table.first;
+        if(currentDatabase->partitions.count(name)) continue;
+        if(tableName.empty() || name == tableName || name.rfind(tableName + "#", 0) == 0) names.push_back(name);
+    }
+    sort(names.begin(), names.end());
+    auto out = openOutput(outputFile);
+    if(!out) {
+        return;
+    }
+    ostream& file = *out;
+    if(isprint)
+    {
+        file<<"---"<<endl;
+    }
+    else
+    {
+        isprint=true;
+    }
+    file << "table,column,type,storage,rows,live_rows,deleted_rows,value_bytes,overhead_bytes" << endl;
+    size_t totalRows = 0, totalDeleted = 0, totalValues = 0, totalOverhead = 0;
+    for(const auto& name : names) {
+        const TableSchema& schema = currentDatabase->schema(name);
+        const RowStore& rows = *currentDatabase->tables.at(name);
+        bool paged = currentDatabase->pagedTables.count(name) > 0;
+        size_t live = rows.size(), deleted = rows.deletedRows(), values = 0, memory = rows.memoryBytes();
+        if(paged) {
+            const vector<Zone>& zones = currentDatabase->pageZones[name];
+            live = 0;
+            memory = zones.capacity() * sizeof(Zone);
+            for(const auto& zone : zones) {
+                live += zone.rows;
+                memory += zone.cols.capacity() * sizeof(ColumnRange);
+            }
+        }
+        const char* storage = paged ? "disk" : "memory";
+        for(size_t c = 0; c < schema.size(); ++c) {
+            size_t bytes = paged ? 0 : rows.valueBytes(c);
+            values += bytes;
+            if(!columns) continue;
+            file << name << "," << schema.columns[c].name << "," << schema.types[c] << "," << storage << ","
+                 << live + deleted << "," << live << "," << deleted << "," << bytes << "," << (paged ? 0 : rows.slotBytes(c)) << endl;
+        }
+        size_t overhead = memory - min(memory, values);
+        file << name << ",*,," << storage << "," << live + deleted << "," << live << "," << deleted << "," << values << "," << overhead << endl;
+        totalRows += live;
+        totalDeleted += deleted;
+        totalValues += values;
+        totalOverhead += overhead;
+    }
+    if(!columns) {
+        file << "total,*,,," << totalRows + totalDeleted << "," << totalRows << "," << totalDeleted << "," << totalValues << "," << totalOverhead << endl;
+    }
+}
+
+//ANALYZE: 扫描整张表, 统计行数、每列不同值个数(按哈希计数), 并从蓄水池样本建立等深直方图
+void analyze_table(const string& tableName)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(!currentDatabase) {
+        cerr << "No database selected" << endl;
+        return;
+    }
+    if(currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
+        cerr << "Table " << tableName << " does not exist" << endl;
+        return;
+    }
+    const auto& schema = currentDatabase->schema(tableName);
+    size_t columns = schema.size();
+    TableStats stats;
+    stats.cols.resize(columns);
+    vector<unordered_set<uint64_t>> hashes(columns);
+    vector<vector<string>> sample;
+    mt19937 rng(42);
+    scanTable(tableName, [&](const RowStore& rows, size_t begin, size_t end) {
+        for(size_t r = begin; r < end; ++r, ++stats.rows) {
+            for(size_t c = 0; c < columns; ++c) {
+                hashes[c].insert(rows.isInteger(c) ? hash<int64_t>()(rows.integer(r, c)) : hash<string_view>()(rows.text(r, c)));
+            }
+            if(sample.size() < STATS_SAMPLE_ROWS) {
+                sample.push_back(rows.row(r));
+            } else {
+                uint64_t slot = rng() % (stats.rows + 1);
+                if(slot < STATS_SAMPLE_ROWS) sample[slot] = rows.row(r);
+            }
+        }
+    });
+    for(size_t c = 0; c < columns; ++c) {
+        ColumnStats& col = stats.cols[c];
+        col.distinct = hashes[c].size();
+        // 样本按列值排序(数值列按数值), 取各分位点作为桶上界
+        char kind = columnKind(schema.types[c]);
+        vector<pair<double,string>> values;
+        for(const auto& row : sample) {
+            double key = 0;
+            if(kind != 'T') {
+                try {
+                    key = kind == 'I' ? static_cast<double>(stoll(row[c])) : parseFloat(row[c]);
+                } catch(...) {
+                    continue;
+                }
+            }
+            values.push_back({key, row[c]});
+        }
+        sort(values.begin(), values.end(), [kind](const pair<double,string>& a, const pair<double,string>& b) {
+            return kind == 'T' ? a.second < b.second : a.first < b.first;
+        });
+        size_t buckets = min(HISTOGRAM_BUCKETS, values.size());
+        for(size_t b = 0; b < buckets; ++b) {
+            col.bounds.push_back(values[(b + 1) * values.size() / buckets - 1].second);
+        }
+    }
+    writeStatsFile(currentDatabase->statsFile(tableName), stats);
+    currentDatabase->tableStats[tableName] = move(stats);
+    touchTable(tableName);  // 统计变了计划可能变, 多表连接的输出顺序随之可能不同
+}
+
+void writeStatsFile(const string& statsFile, const TableStats& stats)
+{
+    ofstream out(statsFile, ios::binary | ios::trunc);
+    stats.write(out);
+    profiler.addWritten(static_cast<uint64_t>(out.tellp()));
+}
+
+//读取表的统计文件, 文件不存在或已损坏时不使用统计
+void readStatsFile(const string& tableName)
+{
+    ifstream in(currentDatabase->statsFile(tableName), ios::binary);
+    TableStats stats;
+    if(in.is_open() && stats.read(in, currentDatabase->schema(tableName).size())) {
+        profiler.addRead(static_cast<uint64_t>(in.tellg()));
+        currentDatabase->tableStats[tableName] = move(stats);
+    } else {
+        currentDatabase->tableStats.erase(tableName);
+    }
+}
+
+void update_table(const string& tableName, const vector<pair<string, string>>& updates, vector<string>& conditions) {
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(!currentDatabase || currentDatabase->tables.find(tableName) == currentDatabase->tables.end()) {
+        return;
+    }
+    ConditionSet where = compileConditions(tableName, conditions);
+
+    // 分区表: 分区列不能改(行会换分区), 其余只改WHERE排除不了的分区
+    auto partitioned = currentDatabase->partitions.find(tableName);
+    if(partitioned == currentDatabase->partitions.end()) {
+        if(!updateRows(tableName, tableName, updates, where)) return;
+    } else {
+        const PartitionSpec& spec = partitioned->second;
+        const string& key = currentDatabase->schema(tableName).columns[spec.col].name;
+        if(any_of(updates.begin(), updates.end(), [&](const pair<string, string>& update) { return update.first == key; })) {
+            cerr << "Cannot UPDATE partition column " << key << " of table " << tableName << endl;
+            return;
+        }
+        for(const auto& part : prunePartitions(tableName, {&where})) {
+            if(!updateRows(part, tableName, updates, where)) return;
+        }
+    }
+    touchTable(tableName);
+    save_database(*currentDatabase);
+}
+
+//UPDATE一张表(或一个分区)中满足WHERE的行; 违反唯一约束时撤销这张表上的改动, 报告并返回false
+bool updateRows(const string& tableName, const string& displayName, const vector<pair<string, string>>& updates, const ConditionSet& where) {
+    materialize(tableName);
+    auto& table = *currentDatabase->tables[tableName];
+    const auto& schema = currentDatabase->schema(tableName);
+
+    // 每条语句只解析一次: 目标列序号, 以及数值表达式中引用的列(拆成文本片段和列序号)
+    struct ResolvedUpdate {
+        size_t index;
+        string type;
+        string value;
+        vector<pair<string,size_t>> pieces;
+    };
+    vector<ResolvedUpdate> resolved;
+    for(const auto& update : updates) {
+        size_t index = schema.indexOf(update.first);
+        if(index == TableSchema::npos) {
+            continue;
+        }
+        ResolvedUpdate ru{index, schema.types[index], update.second, {{update.second, TableSchema::npos}}};
+        if(ru.type == "INTEGER" || ru.type == "FLOAT" || columnKind(ru.type) == 'D') {
+            for(size_t c = 0; c < schema.size(); ++c) {
+                const string& colName = schema.columns[c].name;
+                vector<pair<string,size_t>> split;
+                for(const auto& piece : ru.pieces) {
+                    if(piece.second != TableSchema::npos) {
+                        split.push_back(piece);
+                        continue;
+                    }
+                    size_t start = 0, pos;
+                    while((pos = piece.first.find(colName, start)) != string::npos) {
+                        split.push_back({piece.first.substr(start, pos - start), TableSchema::npos});
+                        split.push_back({"", c});
+                        start = pos + colName.length();
+                    }
+                    split.push_back({piece.first.substr(start), TableSchema::npos});
+                }
+                ru.pieces.swap(split);
+            }
+        }
+        resolved.push_back(ru);
+    }
+
+    vector<uint64_t> selected;
+    {
+        ProfileScope scope(profiler, Phase::FILTER);
+        selectTableRows(table, where, selected);
+    }
+    profiler.addScanned(table.size());
+
+    // 改到PRIMARY KEY/UNIQUE列时: 记下旧值, 改完后把这些行的旧键换成新键, 出现重复时整条语句撤销
+    vector<UniqueIndex*> touched;
+    auto indexes = currentDatabase->uniqueIndexes.find(tableName);
+    if(indexes != currentDatabase->uniqueIndexes.end()) {
+        for(auto& index : indexes->second) {
+            bool changes = any_of(resolved.begin(), resolved.end(), [&](const ResolvedUpdate& update) { return update.index == index.col; });
+            if(changes) touched.push_back(&ensureIndex(tableName, index));
+        }
+    }
+    struct OldValue {
+        size_t row, col;
+        string value;
+    };
+    vector<OldValue> undo;
+    vector<size_t> changedRows;
+    if(!touched.empty()) {
+        forEachSelected(selected, [&](size_t i) {
+            changedRows.push_back(i);
+            for(const auto& update : resolved) undo.push_back({i, update.index, table.get(i, update.index)});
+        });
+    }
+    auto rowKey = [&](size_t row, size_t col) {
+        return table.isInteger(col) ? to_string(table.integer(row, col)) : indexKey(schema.types[col], table.text(row, col));
+    };
+    vector<vector<string>> oldKeys(touched.size());
+    for(size_t t = 0; t < touched.size(); ++t) {
+        for(size_t row : changedRows) oldKeys[t].push_back(rowKey(row, touched[t]->col));
+    }
+
+    // 每行拼表达式、求值用的缓冲区在语句临时内存上, 整条语句共用
+    pmr::string expr(StatementArena::get());
+    pmr::vector<float> values(StatementArena::get());
+    pmr::vector<int64_t> decimals(StatementArena::get());
+    pmr::vector<char> ops(StatementArena::get());
+    forEachSelected(selected, [&](size_t i) {
+        profiler.addEmitted(1);
+        for(const auto& update : resolved) {
+            int precision = 0, scale = 0;
+            bool decimal = decimalType(update.type, precision, scale);
+            if(update.type == "INTEGER" || update.type == "FLOAT" || decimal) {
+                // 替换表达式中的列名为实际值
+                expr.clear();
+                for(const auto& piece : update.pieces) {
+                    if(piece.second == TableSchema::npos) {
+                        expr += piece.first;
+                    } else {
+                        table.appendTo(expr, i, piece.second);
+                    }
+                }
+
+                // 计算表达式结果
+                try {
+                    if(decimal) {
+                        table.set(i, update.index, formatDecimal(evaluateDecimal(expr, precision, scale, decimals, ops), scale));
+                        continue;
+                    }
+                    float result = evaluateExpression(expr, values, ops);
+                    if(update.type == "INTEGER") {
+                        table.set(i, update.index, to_string(static_cast<int>(result)));
+                    } else {
+                        table.set(i, update.index, to_string(result));
+                    }
+                } catch(const out_of_range&) {
+                    cerr << "Value of " << expr << " out of range for " << update.type << endl;
+                } catch(...) {
+                    cerr << "Invalid expression: " << expr << endl;
+                }
+            } else {
+                table.set(i, update.index, update.value);
+            }
+        }
+    });
+
+    for(size_t t = 0; t < touched.size(); ++t) {
+        UniqueIndex& index = *touched[t];
+        for(const auto& key : oldKeys[t]) index.rows.erase(key);
+        for(size_t row : changedRows) {
+            string key = rowKey(row, index.col);
+            if(index.rows.emplace(key, row).second) continue;
+            // 新值与其他行(或本条语句改过的另一行)重复: 恢复所有改动, 索引下次用到时重建
+            string value = table.get(row, index.col);
+            for(auto it = undo.rbegin(); it != undo.rend(); ++it) table.set(it->row, it->col, it->value);
+            invalidateIndexes(tableName);
+            cerr << "Duplicate value " << value << " for " << index.label() << " column "
+                 << schema.columns[index.col].name << " in table " << displayName << endl;
+            return false;
+        }
+    }
+    if(tableName != displayName) touchTable(tableName);
+    return true;
+}
+
+void deleteFromTable(const string& tableName, vector<string>& conditions)
+{
+    ProfileScope scope(profiler, Phase::EXECUTE);
+    if(currentDatabase && currentDatabase->tables.find(tableName)!=currentDatabase->tables.end())
+    {
+        ConditionSet where = compileConditions(tableName, conditions);
+        if(currentDatabase->partitions.count(tableName))
+        {
+            // 分区表只删WHERE排除不了的分区中的行
+            for(const auto& part : prunePartitions(tableName, {&where}))
+            {
+                deleteRows(part, where);
+                touchTable(part);
+            }
+        }
+        else
+        {
+            deleteRows(tableName, where);
+        }
+        touchTable(tableName);
+        save_database(*currentDatabase);
+    }
+}
+
+//删除一张表(或一个分区)中满足WHERE的行, WHERE为空时清空
+void deleteRows(const string& tableName, const ConditionSet& where)
+{
+    materialize(tableName);
+    auto& table = *currentDatabase->tables[tableName];
+    size_t before = table.size();
+    profiler.addScanned(before);
+    if(where.empty())
+    {
+        table.clear();
+    }
+    else
+    {
+        vector<uint64_t> selected;
         {
-            size_t semicolonPos = line.find(';',pos);
-            if(semicolonPos!=string::npos)//处理不规范换行的情况
-            {
-                string temp=line.substr(pos,semicolonPos-pos);
-                sqlCommand+=temp;
+            ProfileScope scope(profiler, Phase::FILTER);
+            selectTableRows(table, where, selected);
+        }
+        table.removeIf([&](size_t i) { return (selected[i / 64] >> (i % 64)) & 1; });
+    }
+    invalidateIndexes(tableName);  // 保留的行前移了
+    profiler.addEmitted(before - table.size());
+}
+
+void save_database(const Database& db) {
+    // 并行执行一段语句时写回会读所有表, 先只记下, 这段语句都执行完后由执行器写回一次
+    if(deferSave) {
+        savePending = true;
+        return;
+    }
+    ProfileScope scope(profiler, Phase::SAVE);
+    ofstream file(db.name+".db");
+    if(db.tables.empty()) return;
+    
+    for(const auto& table : db.tables) {
+        file << "TABLE " << " " << table.first << endl;
+        
+        // 先写入列名和类型
+        const auto& columns = db.tableColumns.at(table.first);
+        for(size_t i = 0; i < columns.size(); ++i) {
+            file << columns[i].name << " " << columns[i].type;
+            if(i < columns.size() - 1) {
+                file << " ";
+            }
+        }
+        file << endl;
+        auto indexes = db.uniqueIndexes.find(table.first);
+        if(indexes != db.uniqueIndexes.end()) {
+            for(const auto& index : indexes->second) {
+                file << "KEY " << (index.primary ? "PRIMARY" : "UNIQUE") << " " << columns[index.col].name << endl;
+            }
+        }
+        // 分区表本身没有行, 只记分区方式; 各分区作为子表各自写出
+        auto partitioned = db.partitions.find(table.first);
+        if(partitioned != db.partitions.end()) {
+            const PartitionSpec& spec = partitioned->second;
+            file << "PARTITION " << (spec.range ? "RANGE " : "HASH ") << columns[spec.col].name;
+            if(spec.range) {
+                for(const auto& bound : spec.bounds) file << " " << bound;
+            } else {
+                file << " " << spec.count;
+            }
+            file << endl << "end" << endl;
+            continue;
+        }
+        
+        // 数据写入页文件: 已在页文件中的表只写回缓冲池中的脏页
+        string pageFile = db.pageFile(table.first);
+        if(db.pagedTables.count(table.first)) {
+            bufferPool.flush(pageFile);
+            auto zones = db.pageZones.find(table.first);
+            if(zones != db.pageZones.end() && zones->second.size() == bufferPool.pageCount(pageFile)) {
+                writeZoneFile(db.zoneFile(table.first), zones->second);
+            } else {
+                remove(db.zoneFile(table.first).c_str());
+            }
+        } else {
+            writePageFile(pageFile, db.zoneFile(table.first), db.overflowFile(table.first), *table.second);
+        }
+        file << "PAGED" << endl;
+        file << "end" << endl;
+    }
+    profiler.addWritten(static_cast<uint64_t>(file.tellp()));
+}
+
+void load_database(const string& db) {
+    ProfileScope scope(profiler, Phase::LOAD);
+    ifstream file(db);
+    if (!file.is_open()) {
+        cerr << "Unable to open file: " << db << endl;
+        return;
+    }
+    string dbName = db.substr(0, db.find_last_of('.'));
+    currentDatabase = &databases[dbName];
+    currentDatabase->name = dbName;
+    currentDatabase->pagedTables.clear();
+    currentDatabase->tableVersions.clear();
+    currentDatabase->pageZones.clear();
+    currentDatabase->tableStats.clear();
+    currentDatabase->uniqueIndexes.clear();
+    currentDatabase->partitions.clear();
+    string line, current_table;
+    bool isFirstRow = true;
+    
+    while(getline(file, line)) {
+        profiler.addRead(line.size() + 1);
+        if(line.substr(0,5) == "TABLE") {
+            current_table = line.substr(7);
+            currentDatabase->tables[current_table] = make_shared<RowStore>();
+            touchTable(current_table);
+            isFirstRow = true;
+        }
+        else if(line == "end") {
+            isFirstRow = true;
+            continue;
+        }
+        else if(!isFirstRow && line.compare(0, 4, "KEY ") == 0) {
+            // KEY PRIMARY|UNIQUE 列名: 列约束, 索引在第一次用到时建立
+            istringstream iss(line.substr(4));
+            string kind, column;
+            iss >> kind >> column;
+            size_t col = currentDatabase->schema(current_table).indexOf(column);
+            if(col != TableSchema::npos) {
+                currentDatabase->uniqueIndexes[current_table].emplace_back(col, kind == "PRIMARY");
+            }
+        }
+        else if(!isFirstRow && line.compare(0, 10, "PARTITION ") == 0) {
+            // PARTITION HASH 列名 分区数 / PARTITION RANGE 列名 上界...: 分区表, 行在子表 表名#序号 中
+            istringstream iss(line.substr(10));
+            string kind, column, word;
+            iss >> kind >> column;
+            PartitionSpec spec;
+            spec.range = kind == "RANGE";
+            spec.col = currentDatabase->schema(current_table).indexOf(column);
+            if(spec.col == TableSchema::npos) continue;
+            spec.type = currentDatabase->schema(current_table).types[spec.col];
+            while(iss >> word) spec.bounds.push_back(word);
+            if(!spec.range) {
+                spec.count = spec.bounds.empty() ? DEFAULT_PARTITIONS : stoul(spec.bounds[0]);
+                spec.bounds.clear();
+            } else {
+                spec.count = spec.bounds.size() + 1;
+            }
+            currentDatabase->partitions[current_table] = move(spec);
+        }
+        else if(!isFirstRow && line == "PAGED") {
+            // 数据在页文件中, 扫描时经缓冲池按页读取
+            currentDatabase->pagedTables.insert(current_table);
+            currentDatabase->pageZones[current_table] = readZoneFile(currentDatabase->zoneFile(current_table), currentDatabase->schema(current_table).size());
+        }
+        else if(isFirstRow) {
+            // 处理列名和类型行
+            istringstream iss(line);
+            vector<string> columnTypes;
+            vector<Column> tableColumns;
+            string name, type;
             
-            if(!sqlCommand.empty())
-            {
-                sqlCommand = trim(sqlCommand);
+            while(iss >> name >> type) {
+                columnTypes.push_back(type);
+                tableColumns.push_back({name, type});
+            }
+            
+            currentDatabase->tables[current_table] = make_shared<RowStore>(columnTypes);
+            currentDatabase->setColumns(current_table, tableColumns);
+            readStatsFile(current_table);
+            isFirstRow = false;
+        }
+        else {
+            // 处理数据行
+            vector<string> values;
+            string value;
+            istringstream iss(line);
+            bool inQuotes = false;
+            string currentValue;
+            
+            for(char c : line) {
+                if(c == '\'') {
+                    inQuotes = !inQuotes;
+                    currentValue += c;
+                }
+                else if(c == ' ' && !inQuotes) {
+                    if(!currentValue.empty()) {
+                        values.push_back(currentValue);
+                        currentValue.clear();
+                    }
+                }
+                else {
+                    currentValue += c;
+                }
+            }
+            if(!currentValue.empty()) {
+                values.push_back(currentValue);
+            }
+            
+            if(!values.empty()) {
+                currentDatabase->tables[current_table]->append(values);
+            }
+        }
+    }
+    file.close();
+    for(const auto& table : currentDatabase->tables) chargeTable(table.first);
+}
+//专门的比较函数
+bool compareValues(string_view value1, const string& value2, const string& type, const string& op) {
+    if(type == "INTEGER") {
+        return compareIntegers(stoll(string(value1)), stoll(value2), op);
+    }
+    else if(type == "FLOAT") {
+        
+        string val1(value1);
+        string val2 = value2;
+        if(val1.front() == '\'') val1 = val1.substr(1, val1.length()-2);
+        if(val2.front() == '\'') val2 = val2.substr(1, val2.length()-2);
+        
+        float v1 = stof(val1);
+        float v2 = stof(val2);
+        if(op == "=") return v1 == v2;
+        if(op == "<") return v1 < v2;
+        if(op == ">") return v1 > v2;
+        if(op =="!=") return v1!=v2;
+    }
+    else { 
+        if(op == "=") return value1 == value2;
+        if(op == "<") return value1 < value2;
+        if(op == ">") return value1 > value2;
+        if(op =="!=") return value1!=value2;
+    }
+    return false;
+}
+
+bool compareIntegers(int64_t v1, int64_t v2, const string& op) {
+    if(op == "=") return v1 == v2;
+    if(op == "<") return v1 < v2;
+    if(op == ">") return v1 > v2;
+    if(op =="!=") return v1!=v2;
+    return false;
+}
+//表达式计算函数; values和ops是调用方提供的栈, 反复求值时不再每次分配
+//表达式不完整(缺操作数)时抛出invalid_argument
+float evaluateExpression(string_view expr, pmr::vector<float>& values, pmr::vector<char>& ops) {
+    values.clear();
+    ops.clear();
+    auto reduce = [&] {
+        if(values.size() < 2) throw invalid_argument("missing operand");
+        float val2 = values.back(); values.pop_back();
+        float val1 = values.back(); values.pop_back();
+        char op = ops.back(); ops.pop_back();
+        values.push_back(applyOp(val1, val2, op));
+    };
+
+    for(size_t i = 0; i < expr.size(); ++i) {
+        char c = expr[i];
+        if(isspace(static_cast<unsigned char>(c))) continue;
+        
+        if(isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            float val;
+            auto parsed = from_chars(expr.data() + i, expr.data() + expr.size(), val);
+            if(parsed.ec != errc()) throw invalid_argument("bad number");
+            values.push_back(val);
+            i = parsed.ptr - expr.data() - 1;
+        } else if(c == '(') {
+            ops.push_back(c);
+        } else if(c == ')') {
+            while(!ops.empty() && ops.back() != '(') reduce();
+            if(!ops.empty()) ops.pop_back();
+        } else if(c == '+' || c == '-' || c == '*' || c == '/') {
+            while(!ops.empty() && precedence(ops.back()) >= precedence(c)) reduce();
+            ops.push_back(c);
+        }
+    }
+    
+    while(!ops.empty()) reduce();
+    if(values.empty()) throw invalid_argument("empty expression");
+    return values.back();
+}
+
+float applyOp(float a, float b, char op) {
+    switch(op) {
+        case '+': return a + b;
+        case '-': return a - b;
+        case '*': return a * b;
+        case '/': return a / b;
+    }
+    return 0;
+}
+
+//DECIMAL列的表达式: 每个数按目标列的小数位数缩放为整数(多出的小数位四舍五入), 运算都在整数上进行;
+//乘除的中间结果用128位整数, 再四舍五入回scale位小数; 除以0时抛出invalid_argument, 结果超出precision位时抛出out_of_range
+int64_t evaluateDecimal(string_view expr, int precision, int scale, pmr::vector<int64_t>& values, pmr::vector<char>& ops) {
+    values.clear();
+    ops.clear();
+    auto reduce = [&] {
+        if(values.size() < 2) throw invalid_argument("missing operand");
+        int64_t val2 = values.back(); values.pop_back();
+        int64_t val1 = values.back(); values.pop_back();
+        char op = ops.back(); ops.pop_back();
+        values.push_back(applyDecimalOp(val1, val2, op, scale));
+    };
+
+    for(size_t i = 0; i < expr.size(); ++i) {
+        char c = expr[i];
+        if(isspace(static_cast<unsigned char>(c))) continue;
+
+        if(isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            size_t end = i;
+            while(end < expr.size() && (isdigit(static_cast<unsigned char>(expr[end])) || expr[end] == '.')) ++end;
+            DecimalValue d;
+            if(!parseDecimal(expr.substr(i, end - i), scale, d)) throw invalid_argument("bad number");
+            values.push_back(d.rounded);
+            i = end - 1;
+        } else if(c == '(') {
+            ops.push_back(c);
+        } else if(c == ')') {
+            while(!ops.empty() && ops.back() != '(') reduce();
+            if(!ops.empty()) ops.pop_back();
+        } else if(c == '+' || c == '-' || c == '*' || c == '/') {
+            while(!ops.empty() && precedence(ops.back()) >= precedence(c)) reduce();
+            ops.push_back(c);
+        }
+    }
+
+    while(!ops.empty()) reduce();
+    if(values.empty()) throw invalid_argument("empty expression");
+    if(!decimalFits(values.back(), precision)) throw out_of_range("decimal overflow");
+    return values.back();
+}
+
+//n / d四舍五入(远离0)
+static __int128 divideRounded(__int128 n, __int128 d) {
+    __int128 q = n / d, r = n % d;
+    if(r < 0) r = -r;
+    if(2 * r >= (d < 0 ? -d : d)) q += (n < 0) == (d < 0) ? 1 : -1;
+    return q;
+}
+
+//两个按10^scale缩放的数运算, 结果仍按10^scale缩放; 中间结果超出18位有效数字时抛出out_of_range
+int64_t applyDecimalOp(int64_t a, int64_t b, char op, int scale) {
+    __int128 factor = pow10i(scale), result = 0;
+    switch(op) {
+        case '+': result = static_cast<__int128>(a) + b; break;
+        case '-': result = static_cast<__int128>(a) - b; break;
+        case '*': result = divideRounded(static_cast<__int128>(a) * b, factor); break;
+        case '/':
+            if(b == 0) throw invalid_argument("division by zero");
+            result = divideRounded(static_cast<__int128>(a) * factor, b);
+            break;
+    }
+    __int128 limit = pow10i(MAX_DECIMAL_PRECISION);
+    if(result <= -limit || result >= limit) throw out_of_range("decimal overflow");
+    return static_cast<int64_t>(result);
+}
+
+int precedence(char op) {
+    if(op == '+' || op == '-') return 1;
+    if(op == '*' || op == '/') return 2;
+    return 0;
+}
+//计算块[begin,end)中满足WHERE的行的选择位图
+//数值列上的=,!=,<,>先把列取成连续数组再走向量化内核, 其它条件逐行求值; 两个条件按字AND/OR合并
+void selectRows(const RowStore& rows, size_t begin, size_t end, const ConditionSet& where, vector<uint64_t>& bits) {
+    size_t n = end - begin;
+    size_t words = (n + 63) / 64;
+    if (where.empty() || (where.logicalOp != "" && where.logicalOp != "AND" && where.logicalOp != "OR")) {
+        bits.assign(words, ~0ULL);
+        if (n % 64) bits.back() = (1ULL << (n % 64)) - 1;
+        return;
+    }
+    conditionBits(rows, begin, end, where.conds[0], bits);
+    if (where.logicalOp.empty()) {
+        return;
+    }
+    vector<uint64_t> other(words, 0);
+    if (where.conds.size() > 1) {
+        conditionBits(rows, begin, end, where.conds[1], other);
+    }
+    for (size_t w = 0; w < words; ++w) {
+        bits[w] = where.logicalOp == "AND" ? bits[w] & other[w] : bits[w] | other[w];
+    }
+}
+
+void conditionBits(const RowStore& rows, size_t begin, size_t end, const Condition& cond, vector<uint64_t>& bits) {
+    size_t n = end - begin;
+    bits.assign((n + 63) / 64, 0);
+    if (cond.index == TableSchema::npos) {
+        return;
+    }
+    if (cond.cmp != CmpOp::OTHER && integralType(cond.type)) {
+        vector<int64_t> column(n);
+        for (size_t i = 0; i < n; ++i) column[i] = rows.integer(begin + i, cond.index);
+        filterInt64(column.data(), n, cond.cmp, cond.intValue, bits.data());
+    } else if (cond.cmp != CmpOp::OTHER && cond.type == "FLOAT") {
+        vector<float> column(n);
+        for (size_t i = 0; i < n; ++i) column[i] = parseFloat(rows.text(begin + i, cond.index));
+        filterFloat(column.data(), n, cond.cmp, cond.floatValue, bits.data());
+    } else {
+        for (size_t i = 0; i < n; ++i) {
+            if (evaluateCondition(rows, begin + i, cond)) bits[i / 64] |= 1ULL << (i % 64);
+        }
+    }
+}
+
+//整张内存表的选择位图: 块统计表明不可能满足条件的块直接置零, 其余块按块计算
+void selectTableRows(const RowStore& table, const ConditionSet& where, vector<uint64_t>& bits) {
+    bits.assign((table.size() + 63) / 64, 0);
+    const auto& zones = table.zones();
+    vector<uint64_t> block;
+    for (size_t begin = 0, k = 0; begin < table.size(); begin += BLOCK_ROWS, ++k) {
+        if (k < zones.size() && !zones[k].mayMatch(where)) continue;
+        selectRows(table, begin, min(table.size(), begin + BLOCK_ROWS), where, block);
+        copy(block.begin(), block.end(), bits.begin() + begin / 64);  // BLOCK_ROWS是64的倍数
+    }
+}
+
+//按位图中置位的顺序回调行号(相对块起点)
+template<typename Fn>
+static void forEachSelected(const vector<uint64_t>& bits, Fn fn) {
+    for (size_t w = 0; w < bits.size(); ++w) {
+        uint64_t word = bits[w];
+        while (word) {
+            fn(w * 64 + __builtin_ctzll(word));
+            word &= word - 1;
+        }
+    }
+}
+
+//把WHERE条件的词序列解析为条件组, 列名在这里一次性定位, 之后逐行求值不再查找
+ConditionSet compileConditions(const string& tableName, const vector<string>& conditions) {
+    ConditionSet result;
+    if (conditions.empty()) {
+        return result;
+    }
+
+    // 词序列为 条件 [AND|OR 条件], 第4个词是逻辑运算符, 直接按位置取, 不再复制
+    if (conditions.size() > 3) {
+        result.logicalOp = conditions[3];
+    }
+    if (conditions.size() < 3 || (conditions.size() > 4 && conditions.size() < 7)) {
+        throw runtime_error("Invalid WHERE clause");
+    }
+
+    const auto& schema = currentDatabase->schema(tableName);
+    result.conds.push_back(resolveCondition(schema, conditions[0], conditions[1], conditions[2]));
+    if (conditions.size() > 4) {
+        result.conds.push_back(resolveCondition(schema, conditions[4], conditions[5], conditions[6]));
+    }
+    return result;
+}
+
+Condition resolveCondition(const TableSchema& schema, const string& columnName, const string& op, const string& value) {
+    Condition cond;
+    cond.index = schema.indexOf(columnName);
+    cond.op = op;
+    cond.value = value;
+    if (cond.index == TableSchema::npos) {
+        cerr << "Column " << columnName << " does not exist" << endl;
+    } else {
+        cond.type = schema.types[cond.index];
+        cond.cmp = parseCmpOp(op);
+        if (cond.type == "INTEGER") {
+            cond.intValue = stoll(value);
+        } else if (cond.type == "FLOAT") {
+            cond.floatValue = parseFloat(value);
+        } else if (columnKind(cond.type) == 'D') {
+            resolveDecimalCondition(cond);
+        }
+    }
+    return cond;
+}
+
+//DECIMAL列的比较值按列的小数位数缩放; 比较值的小数位更多时换成等价的整数比较:
+//x > 1.005即x > 1.00, x < 1.005即x < 1.01; =不可能成立, !=总成立(缩放后的值都在int64最小值之上)
+void resolveDecimalCondition(Condition& cond) {
+    DecimalValue d;
+    if (!parseDecimal(cond.value, decimalScale(cond.type), d)) {
+        throw runtime_error("Invalid DECIMAL value: " + cond.value);
+    }
+    cond.intValue = d.floor;
+    if (d.exact || cond.cmp == CmpOp::GT || cond.cmp == CmpOp::OTHER) return;
+    if (cond.cmp == CmpOp::LT) {
+        cond.intValue = d.floor + 1;
+        return;
+    }
+    cond.op = cond.cmp == CmpOp::EQ ? "<" : ">";
+    cond.cmp = parseCmpOp(cond.op);
+    cond.intValue = numeric_limits<int64_t>::min();
+}
+
+//处理WHERE条件
+bool evaluateConditions(const RowStore& rows, size_t row, const ConditionSet& where) {
+    if (where.empty()) {
+        return true;
+    }
+
+    // 处理条件1
+    bool cond1 = evaluateCondition(rows, row, where.conds[0]);
+    if (where.logicalOp.empty()) {
+        return cond1;
+    }
+
+    // 应用逻辑运算符
+    if (where.logicalOp == "AND") {
+        return cond1 && where.conds.size() > 1 && evaluateCondition(rows, row, where.conds[1]);
+    } else if (where.logicalOp == "OR") {
+        return cond1 || (where.conds.size() > 1 && evaluateCondition(rows, row, where.conds[1]));
+    }
+    return true;
+}
+
+bool evaluateCondition(const RowStore& rows, size_t row, const Condition& cond) {
+    if (cond.index == TableSchema::npos) {
+        return false;
+    }
+    if (rows.isInteger(cond.index)) {
+        return compareIntegers(rows.integer(row, cond.index), cond.intValue, cond.op);
+    }
+    return compareValues(rows.text(row, cond.index), cond.value, cond.type, cond.op);
+}
+
+//把 表.列 拆成(表, 列)
+static pair<string,string> splitQualified(const string& name) {
+    size_t dot_pos = name.find('.');
+    if (dot_pos == string::npos) {
+        return {"", name};
+    }
+    return {name.substr(0, dot_pos), name.substr(dot_pos + 1)};
+}
+
+};
+//移除两端的空白字符
+string trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\n\r");
+    if (first == std::string::npos) return "";
+    size_t last = str.find_last_not_of(" \t\n\r");
+    return str.substr(first, last - first + 1);
+}
+
+//解析单表SELECT在SELECT之后的部分: 列名, FROM的表, WHERE条件; 列为*时展开为表的所有列
+void parseSelect(istringstream& iss, MiniDB& db, SelectQuery& query)
+{
+    vector<string>& columns = query.columns;
+    string& tablename = query.table;
+    vector<string>& conditions = query.conditions;
+    string value, extra;
+    while (iss >> value) {
+        if (value == "FROM") {
+            break;
+        }
+        if (value == "*") {
+            // 如果是*，跳过并在后面处理
+            iss >> extra; // 读取 FROM
+            break;
+        }
+        if(value.back()==',') {
+            value.pop_back();
+        }
+        columns.push_back(value);
+    }
+    
+    iss >> tablename;
+    
+    // 如果是*，获取表的所有列名
+    if (columns.empty() || columns[0] == "*") {
+        if (db.currentDatabase && 
+            db.currentDatabase->tables.find(tablename) != db.currentDatabase->tables.end()) {
+            columns = db.currentDatabase->schema(tablename).names();
+        }
+    }
+    
+    // size_t wherePos = sqlCommand.find("WHERE");
+    // if (wherePos != string::npos) {
+    //     string conditionStr = sqlCommand.substr(wherePos + 6);
+    //     istringstream conditionStream(conditionStr);
+    //     string cond;
+    //     while (conditionStream >> cond) {
+    //         if(cond.front()=='\''||cond.back()!='\''){
+    //             string next_item;
+    //             while(conditionStream>>next_item)
+    //             {
+    //                 if(next_item.back()=='\'')
+    //                 {
+    //                     cond=cond+" "+next_item;
+    //                     break;
+    //                 }
+    //                 cond=cond+" " +next_item;
+    //             }
+    //         }
+    //         conditions.push_back(cond);
+    //     }
+    // }
+    string token;
+    while (iss >> token) {
+        if (token == "WHERE") {
+            string cond;
+            string condition;
+            getline(iss, condition);
+            condition = trim(condition);
+            // 解析条件
+            istringstream conditionStream(condition);
+            while (conditionStream >> cond) {
+                if(cond.front()=='\''&&cond.back()!='\''){
+                    string next_item;
+                    while(conditionStream>>next_item)
+                    {
+                        if(next_item.back()=='\'')
+                        {
+                            cond=cond+" "+next_item;
+                            break;
+                        }
+                        cond=cond+" " +next_item;
+                    }
+                }
+                conditions.push_back(cond);
+            }
+            break;
+        }
+    }
+}
+
+//INNER JOIN语句: SELECT 列, ... FROM 表 INNER JOIN 表 ON a = b [INNER JOIN 表 ON c = d ...] [WHERE ...]
+//conditions的前2*(表数-1)项是每一步ON两边的列, 其后是WHERE条件
+struct JoinQuery {
+    vector<string> tables, columns, conditions;
+};
+
+void parseJoin(istringstream& iss, const string& sqlCommand, JoinQuery& query)
+{
+    vector<string>& columns = query.columns;
+    vector<string>& tables = query.tables;
+    vector<string>& conditions = query.conditions;
+    string word, table;
+    while(iss >> word && word != "FROM") {
+        // 去掉逗号
+        if(word.back() == ',') word.pop_back();
+        if(!word.empty()) columns.push_back(word);
+    }
+    iss >> table;
+    tables.push_back(table);
+    while(iss >> word && word == "INNER") {
+        string join, on, left, equals, right;
+        iss >> join >> table >> on >> left >> equals >> right;
+        tables.push_back(table);
+        conditions.push_back(left);
+        conditions.push_back(right);
+    }
+
+    size_t where_pos = sqlCommand.find("WHERE");
+    if(where_pos != string::npos) {
+        string conditionStr = sqlCommand.substr(where_pos + 6);
+        istringstream conditionStream(conditionStr);
+        string cond;
+        while(conditionStream >> cond) {
+            if(cond.front() == '\'' && cond.back() != '\'') {
+                string next_item;
+                while(conditionStream >> next_item) {
+                    if(next_item.back() == '\'') {
+                        cond = cond + " " + next_item;
+                        break;
+                    }
+                    cond = cond + " " + next_item;
+                }
+            }
+            conditions.push_back(cond);
+        }
+    }
+}
+
+//执行一条完整的SQL语句(已去掉分号和首尾空白), 错误只影响这一条
+void executeStatement(const string& sqlCommand, const string& outputFile, MiniDB& db, int lineNum)
+{
+            StatementScope profile(db.profiler, sqlCommand, lineNum);
+            StatementArena arena;
             try {
                 // 存储原始命令用于错误报告(不想删了)
                 string originalCommand = sqlCommand;
@@ -762,12 +5916,28 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
                 if (command != "CREATE" && command != "USE" && 
                     command != "INSERT" && command != "SELECT" && 
                     command != "UPDATE" && command != "DELETE" && 
-                    command != "DROP") {
+                    command != "DROP" && command != "EXPLAIN" &&
+                    command != "ANALYZE" && command != "SHOW") {
                     cerr << "Error at line " << lineNum << ": Invalid command" << endl;
                     cerr << "Command: " << originalCommand << endl;
-                    sqlCommand.clear();
-                    continue;
+                    return;
                 }//处理不规范
+
+                // EXPLAIN [ANALYZE] SELECT ...: 按SELECT解析执行, 输出查询计划代替结果行
+                QueryPlan plan;
+                bool explain = command == "EXPLAIN";
+                if(explain) {
+                    iss >> command;
+                    if(command == "ANALYZE") {
+                        plan.analyze = true;
+                        iss >> command;
+                    }
+                    if(command != "SELECT") {
+                        cerr << "Error at line " << lineNum << ": EXPLAIN supports only SELECT" << endl;
+                        cerr << "Command: " << originalCommand << endl;
+                        return;
+                    }
+                }
                 
                 if(command=="CREATE")
                 {
@@ -783,18 +5953,31 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
                     {
                         string tableName;
                         iss>>tableName;
+                        // 每个列定义为"列名 类型 [PRIMARY KEY|UNIQUE]", 以逗号结束, 最后一个以)结束
                         vector<string> columns;
-                        string column_name,column_type,extra;
+                        string word,extra,definition;
                         iss>>extra;
-                        while(iss>>column_name>>column_type)
+                        while(iss>>word && word!=")")
                         {
-                            if(column_type.back()==',')
+                            // DECIMAL(p, s)括号中的空格去掉, 逗号不结束列定义
+                            bool open=count(definition.begin(),definition.end(),'(')>count(definition.begin(),definition.end(),')');
+                            definition+=(definition.empty()||open?"":" ")+word;
+                            open=count(definition.begin(),definition.end(),'(')>count(definition.begin(),definition.end(),')');
+                            if(definition.back()==','&&!open)
                             {
-                                column_type.pop_back();
+                                definition.pop_back();
+                                columns.push_back(definition);
+                                definition.clear();
                             }
-                            columns.push_back(column_name+" "+column_type);
                         }
-                        db.create_table(tableName,columns);
+                        if(!definition.empty())
+                        {
+                            columns.push_back(definition);
+                        }
+                        // 列定义之后可以跟PARTITION BY子句
+                        string partitionBy;
+                        getline(iss,partitionBy);
+                        db.create_table(tableName,columns,trim(partitionBy));
                     }
                 }
                 else if(command=="DROP")
@@ -803,6 +5986,43 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
                     iss>>extra>>name;
                     db.drop_table(name);
                 }
+                else if(command=="ANALYZE")
+                {
+                    // ANALYZE [表名]: 不给表名时分析当前数据库的所有表
+                    string name;
+                    if(iss>>name) {
+                        db.analyze_table(name);
+                    } else if(db.currentDatabase) {
+                        vector<string> names;
+                        for(const auto& table : db.currentDatabase->tables) {
+                            if(!Database::isPartition(table.first)) names.push_back(table.first);
+                        }
+                        sort(names.begin(), names.end());
+                        for(const auto& table : names) db.analyze_table(table);
+                    } else {
+                        cerr << "No database selected" << endl;
+                    }
+                }
+                else if(command=="SHOW")
+                {
+                    // SHOW TABLE STATS [表名] / SHOW MEMORY
+                    string what,extra,name;
+                    iss>>what;
+                    if(what=="TABLE"&&iss>>extra&&extra=="STATS")
+                    {
+                        iss>>name;
+                        db.show_stats(name,true,outputFile);
+                    }
+                    else if(what=="MEMORY")
+                    {
+                        db.show_stats("",false,outputFile);
+                    }
+                    else
+                    {
+                        cerr << "Error at line " << lineNum << ": SHOW supports TABLE STATS and MEMORY" << endl;
+                        cerr << "Command: " << originalCommand << endl;
+                    }
+                }
                 else if(command=="USE")
                 {
                     string extra,name;
@@ -810,122 +6030,27 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
                     db.use_database(name);
                 }
                 else if (command == "SELECT") {
-                    vector<string> columns;
-                    string value, extra;
                     size_t innerJoinPos = sqlCommand.find("INNER JOIN");
                     
                     if (innerJoinPos != string::npos) {
                         // 处理 INNER JOIN 语句
-                        string res_table, join_table, res_column, join_column, condition1, condition2;
-                        string from, inner, join, on;
-                        iss >> res_column >> join_column >> from >> res_table >> inner >> join >> join_table >> on >> condition1 >> extra >> condition2;
-                        
-                        // 去掉逗号
-                        res_column.pop_back();
-                        
-                        vector<string> columns = {res_column, join_column};
-                        vector<string> conditions = {condition1, condition2};
-
-                        size_t where_pos = sqlCommand.find("WHERE");
-                        if(where_pos != string::npos) {
-                            string conditionStr = sqlCommand.substr(where_pos + 6);
-                            istringstream conditionStream(conditionStr);
-                            string cond;
-                            while(conditionStream >> cond) {
-                                if(cond.front() == '\'' && cond.back() != '\'') {
-                                    string next_item;
-                                    while(conditionStream >> next_item) {
-                                        if(next_item.back() == '\'') {
-                                            cond = cond + " " + next_item;
-                                            break;
-                                        }
-                                        cond = cond + " " + next_item;
-                                    }
-                                }
-                                conditions.push_back(cond);
-                            }
+                        JoinQuery query;
+                        parseJoin(iss, sqlCommand, query);
+                        if(explain) {
+                            db.inner_join_file(query.tables, query.columns, query.conditions, outputFile, &plan);
+                        } else {
+                            db.cachedQuery(sqlCommand, query.tables, outputFile, [&] { db.inner_join_file(query.tables, query.columns, query.conditions, outputFile); });
                         }
-                        
-                        db.inner_join_file(res_table, join_table, columns, conditions, outputFile);
                     } else 
                     {
                         // 处理普通的 SELECT 语句
-                        while (iss >> value) {
-                            if (value == "FROM") {
-                                break;
-                            }
-                            if (value == "*") {
-                                // 如果是*，跳过并在后面处理
-                                iss >> extra; // 读取 FROM
-                                break;
-                            }
-                            if(value.back()==',') {
-                                value.pop_back();
-                            }
-                            columns.push_back(value);
-                        }
-                        
-                        string tablename;
-                        iss >> tablename;
-                        
-                        // 如果是*，获取表的所有列名
-                        if (columns.empty() || columns[0] == "*") {
-                            if (db.currentDatabase && 
-                                db.currentDatabase->tables.find(tablename) != db.currentDatabase->tables.end()) {
-                                columns = db.currentDatabase->tables[tablename].front();
-                            }
-                        }
-                        
-                        vector<string> conditions;
-                        // size_t wherePos = sqlCommand.find("WHERE");
-                        // if (wherePos != string::npos) {
-                        //     string conditionStr = sqlCommand.substr(wherePos + 6);
-                        //     istringstream conditionStream(conditionStr);
-                        //     string cond;
-                        //     while (conditionStream >> cond) {
-                        //         if(cond.front()=='\''||cond.back()!='\''){
-                        //             string next_item;
-                        //             while(conditionStream>>next_item)
-                        //             {
-                        //                 if(next_item.back()=='\'')
-                        //                 {
-                        //                     cond=cond+" "+next_item;
-                        //                     break;
-                        //                 }
-                        //                 cond=cond+" " +next_item;
-                        //             }
-                        //         }
-                        //         conditions.push_back(cond);
-                        //     }
-                        // }
-                        string token;
-                    while (iss >> token) {
-                        if (token == "WHERE") {
-                            string cond;
-                            string condition;
-                            getline(iss, condition);
-                            condition = trim(condition);
-                            // 解析条件
-                            istringstream conditionStream(condition);
-                            while (conditionStream >> cond) {
-                                if(cond.front()=='\''&&cond.back()!='\''){
-                                    string next_item;
-                                    while(conditionStream>>next_item)
-                                    {
-                                        if(next_item.back()=='\'')
-                                        {
-                                            cond=cond+" "+next_item;
-                                            break;
-                                        }
-                                        cond=cond+" " +next_item;
-                                    }
-                                }
-                                conditions.push_back(cond);
-                            }
-                            break;
-                        }
+                        SelectQuery query;
+                        parseSelect(iss, db, query);
+                    if(explain) {
+                        db.select_to_file(query.table, query.columns, query.conditions, outputFile, &plan);
+                    } else {
+                        db.cachedQuery(sqlCommand, {query.table}, outputFile, [&] { db.select_to_file(query.table, query.columns, query.conditions, outputFile); });
                     }
-                    db.select_to_file(tablename, columns, conditions, outputFile);
                     }
                 }
                 else if(command=="INSERT")
@@ -933,11 +6058,18 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
                     string into, tableName, valuesStr;
                     iss >> into >> tableName >> valuesStr;
                     size_t start = sqlCommand.find('(');  //找括号可比去括号快
-                    size_t end = sqlCommand.find(')');
-                    string valuesSegment = sqlCommand.substr(start + 1, end - start - 1);
+                    // 值列表到引号外的第一个)为止, TEXT值中可以有括号
+                    size_t end = start == string::npos ? start : start + 1;
+                    bool quoted = false;
+                    for(; end < sqlCommand.size(); ++end) {
+                        if(sqlCommand[end] == '\'') quoted = !quoted;
+                        else if(sqlCommand[end] == ')' && !quoted) break;
+                    }
+                    string_view valuesSegment = string_view(sqlCommand).substr(start + 1, end - start - 1);
 
-                    vector<string> values;
-                    string current;
+                    // 值只在本条语句内使用, 放在语句临时内存上
+                    ArenaRow values(StatementArena::get());
+                    pmr::string current(StatementArena::get());
                     bool inQuotes = false;
                     for (size_t i = 0; i < valuesSegment.size(); ++i) {
                         char c = valuesSegment[i];
@@ -1003,65 +6135,543 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
                 expr += c;
             }
         }
-        
-        // 清理表达式的空格
-        expression = trim(expr);
-        updates.push_back({column, expression});
+        
+        // 清理表达式的空格
+        expression = trim(expr);
+        updates.push_back({column, expression});
+    }
+
+    // 处理WHERE条件
+    vector<string> conditions;
+    if(wherePos != string::npos) {
+        string conditionStr = sqlCommand.substr(wherePos + 6);
+        istringstream conditionStream(conditionStr);
+        string cond;
+        while(conditionStream >> cond) {
+            if(cond.front() == '\'' && cond.back() != '\'') {
+                string next_item;
+                while(conditionStream >> next_item) {
+                    if(next_item.back() == '\'') {
+                        cond = cond + " " + next_item;
+                        break;
+                    }
+                    cond = cond + " " + next_item;
+                }
+            }
+            conditions.push_back(cond);
+        }
+    }
+
+    db.update_table(tableName, updates, conditions);
+}
+                else if(command=="DELETE")
+                {
+                    string from, tableName, where;
+                    iss >> from >> tableName;
+                    vector<string> conditions;
+                    string condition;
+                    if (iss >> where) {
+                        while (iss >> condition) {
+                            if(condition.front()=='\''&&condition.back()!='\'')
+                            {
+                                string next_item;
+                                while(iss>>next_item)
+                                {
+                                    if(next_item.back()=='\'')
+                                    {
+                                        condition=condition+" "+next_item;
+                                        break;
+                                    }
+                                    condition=condition+" " +next_item;
+                                }
+                            }
+                            conditions.push_back(condition);
+                        }
+                    }
+                    db.deleteFromTable(tableName, conditions);
+                }
+                if(explain) {
+                    db.writePlan(plan, outputFile);
+                }
+            } catch (const exception& e) {
+                cerr << "Error at line " << lineNum << ": " << e.what() << endl;
+                cerr << "Command: " << sqlCommand << endl;
+            }
+}
+
+//能参与共享扫描的语句: 当前数据库中已存在的表上的单表SELECT(不含EXPLAIN和INNER JOIN)
+bool parseSharedSelect(const string& sqlCommand, int lineNum, MiniDB& db, SelectQuery& query)
+{
+    istringstream iss(sqlCommand);
+    string command;
+    iss >> command;
+    if(command != "SELECT" || sqlCommand.find("INNER JOIN") != string::npos) {
+        return false;
+    }
+    parseSelect(iss, db, query);
+    query.sql = sqlCommand;
+    query.line = lineNum;
+    return db.currentDatabase && db.currentDatabase->tables.count(query.table) && !query.columns.empty();
+}
+
+//执行攒下的一组同表SELECT: 只有一条时照常执行, 多条时共享一遍扫描, 输出仍按语句顺序
+//共享扫描中途出错时, 还没写出结果的语句逐条执行, 各自报告自己的错误
+void executeSelectGroup(vector<SelectQuery>& group, const string& outputFile, MiniDB& db)
+{
+    size_t resume = group.size();
+    if(group.size() == 1) {
+        resume = 0;
+    } else if(group.size() > 1) {
+        StatementScope profile(db.profiler, group[0].sql + " [shared scan, " + to_string(group.size()) + " statements]", group[0].line);
+        StatementArena arena;
+        try {
+            db.select_shared(group[0].table, group, outputFile);
+        } catch (const SharedScanError& e) {
+            cerr << "Error at line " << group[e.failed].line << ": " << e.what() << endl;
+            cerr << "Command: " << group[e.failed].sql << endl;
+            resume = e.resume;
+        } catch (const exception& e) {
+            cerr << "Error at line " << group[0].line << ": " << e.what() << endl;
+            cerr << "Command: " << group[0].sql << endl;
+        }
+    }
+    for(size_t i = resume; i < group.size(); ++i) {
+        executeStatement(group[i].sql, outputFile, db, group[i].line);
+    }
+    group.clear();
+}
+
+//按顺序提交一条语句: 单表SELECT先攒进group(同表的连续SELECT共享扫描), 其他语句先执行攒下的group再执行自己
+void submitStatement(vector<SelectQuery>& group, const string& sql, int lineNum, const string& outputFile, MiniDB& db)
+{
+    SelectQuery query;
+    if(parseSharedSelect(sql, lineNum, db, query)) {
+        if(!group.empty() && group[0].table != query.table) {
+            executeSelectGroup(group, outputFile, db);
+        }
+        group.push_back(move(query));
+        return;
+    }
+    executeSelectGroup(group, outputFile, db);
+    executeStatement(sql, outputFile, db, lineNum);
+}
+
+//********** 语句级并行执行 **********
+//脚本按读写的表建依赖图, 互不冲突的语句在线程池上同时执行; 每条语句的结果和报错先写到自己的缓冲, 按语句顺序提交
+
+//固定数量的工作线程, 依次取出提交的任务执行; 析构时等已提交的任务都执行完
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads) {
+        for(size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> lock(latch);
+            stopping = true;
+        }
+        wake.notify_all();
+        for(auto& worker : workers) worker.join();
+    }
+
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> lock(latch);
+            tasks.push_back(move(task));
+        }
+        wake.notify_one();
+    }
+
+private:
+    mutex latch;
+    condition_variable wake;
+    deque<function<void()>> tasks;
+    vector<thread> workers;
+    bool stopping = false;
+
+    void work() {
+        for(;;) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(latch);
+                wake.wait(lock, [&] { return stopping || !tasks.empty(); });
+                if(tasks.empty()) return;
+                task = move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+};
+
+//并行执行期间替换cerr的缓冲: 设置了target的线程(执行语句的工作线程)写到target, 其他线程照常写到原来的缓冲
+class ThreadRoutedBuf : public streambuf {
+public:
+    explicit ThreadRoutedBuf(streambuf* original) : original(original) {}
+
+    static inline thread_local string* target = nullptr;
+
+protected:
+    int overflow(int c) override {
+        if(c == EOF) return 0;
+        if(target) {
+            target->push_back(static_cast<char>(c));
+            return c;
+        }
+        return original->sputc(static_cast<char>(c));
+    }
+
+    streamsize xsputn(const char* text, streamsize n) override {
+        if(target) {
+            target->append(text, static_cast<size_t>(n));
+            return n;
+        }
+        return original->sputn(text, n);
+    }
+
+    int sync() override { return target ? 0 : original->pubsync(); }
+
+private:
+    streambuf* original;
+};
+
+//一条语句读写的表, 只看语句结构不访问数据库; 改变数据库或表结构的语句(CREATE/DROP/USE/ANALYZE)和不认识的语句是屏障
+struct StatementTables {
+    string command;
+    vector<string> reads, writes;
+    bool barrier = false;
+};
+
+StatementTables statementTables(const string& sql)
+{
+    StatementTables t;
+    istringstream iss(sql);
+    string word;
+    iss >> t.command;
+    if(t.command == "EXPLAIN") {
+        iss >> word;
+        if(word == "ANALYZE") iss >> word;
+        if(word != "SELECT") t.barrier = true;
+        t.command = "SELECT";
+    }
+    if(t.command == "SELECT") {
+        // FROM后的表和每个JOIN后的表
+        while(iss >> word && word != "FROM") {}
+        if(iss >> word) t.reads.push_back(word);
+        while(iss >> word) {
+            if(word == "JOIN" && iss >> word) t.reads.push_back(word);
+        }
+    } else if(t.command == "INSERT" || t.command == "DELETE") {
+        iss >> word >> word;  // INSERT INTO 表 / DELETE FROM 表
+        t.writes.push_back(word);
+    } else if(t.command == "UPDATE") {
+        iss >> word;
+        t.writes.push_back(word);
+    }
+    if(t.reads.empty() && t.writes.empty()) t.barrier = true;
+    return t;
+}
+
+//依赖图的一个结点: 一条语句, 或同一张表上连续的单表SELECT(执行时共享扫描)
+struct ScriptUnit {
+    vector<pair<string,int>> statements;  // (语句, 行号)
+    StatementTables tables;
+    string output, errors;
+    vector<size_t> dependents;  // 等这个结点执行完才能执行的结点
+    size_t waiting = 0;         // 还没执行完的前驱结点数
+    bool started = false, done = false;
+    vector<pair<string, vector<size_t>>> pins;  // 写结点开始前替这些读结点固定表的当前版本(它们排在这次写之前)
+    MiniDB::Snapshot snapshot;  // 读结点看到的各表版本
+};
+
+//在当前线程执行一个结点; redirect为true时结果和报错写到结点自己的缓冲
+void runUnit(ScriptUnit& unit, const string& outputFile, MiniDB& db, bool redirect)
+{
+    stringbuf output;
+    if(redirect) {
+        MiniDB::outputBuffer = &output;
+        MiniDB::isprint = false;
+        ThreadRoutedBuf::target = &unit.errors;
+        MiniDB::snapshot = &unit.snapshot;
+    }
+    try {
+        vector<SelectQuery> group;
+        for(const auto& statement : unit.statements) {
+            submitStatement(group, statement.first, statement.second, outputFile, db);
+        }
+        executeSelectGroup(group, outputFile, db);
+    } catch (const exception& e) {
+        cerr << "Error at line " << unit.statements[0].second << ": " << e.what() << endl;
+    }
+    if(redirect) {
+        MiniDB::outputBuffer = nullptr;
+        ThreadRoutedBuf::target = nullptr;
+        MiniDB::snapshot = nullptr;
+        unit.output = output.str();
+    }
+}
+
+//并行执行两个屏障之间的一段结点[first, last), 按结点顺序提交结果
+void runSegment(vector<ScriptUnit>& units, size_t first, size_t last, const string& outputFile, MiniDB& db, ThreadPool& pool)
+{
+    // 执行时会往各语句共用的映射表里插入或删除的项在这里先准备好, 工作线程只改已有的项:
+    // 要UPDATE/DELETE的页存储表先读入内存, 要写的表先取好版本号和块统计的位置
+    // 分区表的语句也读写它的各个分区
+    for(size_t k = first; k < last; ++k) {
+        auto& t = units[k].tables;
+        if(!db.currentDatabase) continue;
+        for(auto* list : {&t.reads, &t.writes}) {
+            for(size_t i = 0, n = list->size(); i < n; ++i) {
+                auto partitioned = db.currentDatabase->partitions.find((*list)[i]);
+                if(partitioned == db.currentDatabase->partitions.end()) continue;
+                for(size_t p = 0; p < partitioned->second.count; ++p) list->push_back(PartitionSpec::partName((*list)[i], p));
+            }
+        }
+        for(const auto& table : t.writes) {
+            if(!db.currentDatabase->tables.count(table)) continue;
+            if(t.command == "UPDATE" || t.command == "DELETE") {
+                db.materialize(table);
+            } else if(db.currentDatabase->pagedTables.count(table)) {
+                db.currentDatabase->pageZones[table];
+            }
+            db.touchTable(table);
+        }
+    }
+
+    // 依赖: 读表t的结点等t上一次的写, 写表t的结点等t上一次的写
+    // 内存中的表多版本并存: 写结点不等排在它前面的读, 开始写之前替还没开始的读固定住当前版本, 有读持有当前版本时先复制再写;
+    // 页存储的表原地追加, 写结点还要等此前所有的读
+    auto inMemory = [&](const string& table) {
+        return db.currentDatabase && db.currentDatabase->tables.count(table) && !db.currentDatabase->pagedTables.count(table);
+    };
+    unordered_map<string, size_t> lastWriter;
+    unordered_map<string, vector<size_t>> readers;
+    for(size_t k = first; k < last; ++k) {
+        vector<size_t> deps;
+        const auto& t = units[k].tables;
+        for(const auto& table : t.reads) {
+            auto w = lastWriter.find(table);
+            if(w != lastWriter.end()) deps.push_back(w->second);
+        }
+        for(const auto& table : t.writes) {
+            auto w = lastWriter.find(table);
+            if(w != lastWriter.end()) deps.push_back(w->second);
+            auto r = readers.find(table);
+            if(r == readers.end()) continue;
+            if(inMemory(table)) {
+                units[k].pins.push_back({table, r->second});
+            } else {
+                deps.insert(deps.end(), r->second.begin(), r->second.end());
+            }
+        }
+        sort(deps.begin(), deps.end());
+        deps.erase(unique(deps.begin(), deps.end()), deps.end());
+        for(size_t d : deps) {
+            if(d == k) continue;
+            units[d].dependents.push_back(k);
+            units[k].waiting++;
+        }
+        for(const auto& table : t.writes) {
+            lastWriter[table] = k;
+            readers.erase(table);
+        }
+        for(const auto& table : t.reads) readers[table].push_back(k);
+    }
+
+    mutex latch;
+    condition_variable finished;
+    function<void(size_t)> launch = [&](size_t k) {
+        pool.submit([&, k] {
+            ScriptUnit& unit = units[k];
+            {
+                lock_guard<mutex> lock(db.snapshotLatch);
+                for(const auto& pin : unit.pins) {
+                    for(size_t r : pin.second) {
+                        if(!units[r].started) units[r].snapshot.emplace(pin.first, db.takeSnapshot(pin.first));
+                    }
+                }
+                for(const auto& table : unit.tables.reads) {
+                    if(inMemory(table) && !unit.snapshot.count(table)) unit.snapshot.emplace(table, db.takeSnapshot(table));
+                }
+                for(const auto& table : unit.tables.writes) {
+                    auto& current = db.currentDatabase->tables[table];
+                    if(inMemory(table) && current.use_count() > 1) current = make_shared<RowStore>(*current);
+                }
+                unit.started = true;
+            }
+            runUnit(unit, outputFile, db, true);
+            {
+                lock_guard<mutex> lock(db.snapshotLatch);
+                unit.snapshot.clear();  // 放开引用: 没有读语句再用的旧版本随之释放
+            }
+            {
+                lock_guard<mutex> lock(latch);
+                units[k].done = true;
+                for(size_t d : units[k].dependents) {
+                    if(--units[d].waiting == 0) launch(d);
+                }
+                finished.notify_all();  // 持锁通知: 主线程提交完最后一个结点就会销毁finished
+            }
+        });
+    };
+
+    db.deferSave = true;
+    {
+        lock_guard<mutex> lock(latch);
+        for(size_t k = first; k < last; ++k) {
+            if(units[k].waiting == 0) launch(k);
+        }
+    }
+    ofstream file(outputFile, ios::app);
+    for(size_t k = first; k < last; ++k) {
+        {
+            unique_lock<mutex> lock(latch);
+            finished.wait(lock, [&] { return units[k].done; });
+        }
+        ScriptUnit& unit = units[k];
+        cerr << unit.errors;
+        if(!unit.output.empty()) {
+            if(MiniDB::isprint)
+            {
+                file<<"---"<<endl;
+            }
+            else
+            {
+                MiniDB::isprint=true;
+            }
+            file << unit.output;
+        }
+        unit.output.clear();
+        unit.errors.clear();
     }
+    db.deferSave = false;
+}
 
-    // 处理WHERE条件
-    vector<string> conditions;
-    if(wherePos != string::npos) {
-        string conditionStr = sqlCommand.substr(wherePos + 6);
-        istringstream conditionStream(conditionStr);
-        string cond;
-        while(conditionStream >> cond) {
-            if(cond.front() == '\'' && cond.back() != '\'') {
-                string next_item;
-                while(conditionStream >> next_item) {
-                    if(next_item.back() == '\'') {
-                        cond = cond + " " + next_item;
-                        break;
-                    }
-                    cond = cond + " " + next_item;
-                }
+//读脚本的线程和执行语句的线程之间的有界队列: 队列满时读线程等待, 执行跟不上时不会把整个脚本读进内存
+class StatementQueue {
+public:
+    explicit StatementQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(string sql, int lineNum) {
+        unique_lock<mutex> lock(latch);
+        notFull.wait(lock, [&] { return statements.size() < capacity; });
+        statements.emplace_back(move(sql), lineNum);
+        notEmpty.notify_one();
+    }
+
+    // 读完整个脚本后调用, 之后pop取完剩下的语句就返回false
+    void close() {
+        lock_guard<mutex> lock(latch);
+        closed = true;
+        notEmpty.notify_one();
+    }
+
+    bool pop(pair<string,int>& statement) {
+        unique_lock<mutex> lock(latch);
+        notEmpty.wait(lock, [&] { return closed || !statements.empty(); });
+        if(statements.empty()) return false;
+        statement = move(statements.front());
+        statements.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+private:
+    mutex latch;
+    condition_variable notFull, notEmpty;
+    deque<pair<string,int>> statements;
+    size_t capacity;
+    bool closed = false;
+};
+
+static const size_t PIPELINE_DEPTH = 256;  // 读线程最多领先执行线程的语句数
+static const size_t PARALLEL_WINDOW = 64;  // 并行执行时一次调度的最多语句数, 窗口之间等前一个窗口执行完
+
+//并行执行队列中的脚本: 屏障语句等前面的都执行完后在当前线程单独执行, 其余语句按依赖图并行执行
+//语句边读边执行: 攒够一个窗口或遇到屏障就执行攒下的这一段, 读线程同时切分后面的语句
+void executeParallel(StatementQueue& queue, const string& outputFile, MiniDB& db, size_t threads)
+{
+    ThreadRoutedBuf routed(cerr.rdbuf());
+    streambuf* original = cerr.rdbuf(&routed);
+    {
+        ThreadPool pool(threads);
+        auto flushSave = [&] {
+            if(db.savePending && db.currentDatabase) {
+                db.savePending = false;
+                db.save_database(*db.currentDatabase);
             }
-            conditions.push_back(cond);
+        };
+        vector<ScriptUnit> units;  // 当前窗口中还没执行的结点
+        size_t windowed = 0;       // 当前窗口中的语句数
+        auto flushWindow = [&] {
+            if(!units.empty()) runSegment(units, 0, units.size(), outputFile, db, pool);
+            units.clear();
+            windowed = 0;
+        };
+        pair<string,int> statement;
+        while(queue.pop(statement)) {
+            StatementTables tables = statementTables(statement.first);
+            if(tables.barrier) {
+                flushWindow();
+                flushSave();
+                ScriptUnit unit;
+                unit.statements.push_back(move(statement));
+                unit.tables = move(tables);
+                runUnit(unit, outputFile, db, false);
+                continue;
+            }
+            bool plainSelect = tables.command == "SELECT" && tables.reads.size() == 1 &&
+                               statement.first.compare(0, 6, "SELECT") == 0 && statement.first.find("INNER JOIN") == string::npos;
+            if(plainSelect && !units.empty() && units.back().tables.reads == tables.reads && units.back().tables.writes.empty() &&
+               units.back().statements.back().first.find("INNER JOIN") == string::npos &&
+               units.back().statements.back().first.compare(0, 6, "SELECT") == 0) {
+                units.back().statements.push_back(move(statement));
+            } else {
+                ScriptUnit unit;
+                unit.statements.push_back(move(statement));
+                unit.tables = move(tables);
+                units.push_back(move(unit));
+            }
+            if(++windowed == PARALLEL_WINDOW) flushWindow();
         }
+        flushWindow();
+        flushSave();
     }
-
-    db.update_table(tableName, updates, conditions);
+    cerr.rdbuf(original);
 }
-                else if(command=="DELETE")
+
+//按分号把脚本切成语句(去掉首尾空白), 连同语句结束所在的行号依次放入队列
+void readScript(ifstream& file, StatementQueue& queue)
+{
+    string line;
+    string sqlCommand;
+    int lineNum = 0;
+    while (getline(file, line)) {
+        lineNum++;
+        // sqlCommand += line + " ";
+        
+        // if (line.find(';')!=string::npos) {
+        //     sqlCommand=trim(sqlCommand);
+        //     sqlCommand.pop_back();
+        size_t pos=0;
+        while(pos<line.length())
+        {
+            size_t semicolonPos = line.find(';',pos);
+            if(semicolonPos!=string::npos)//处理不规范换行的情况
+            {
+                string temp=line.substr(pos,semicolonPos-pos);
+                sqlCommand+=temp;
+            
+            if(!sqlCommand.empty())
+            {
+                sqlCommand = trim(sqlCommand);
+                if(!sqlCommand.empty())
                 {
-                    string from, tableName, where;
-                    iss >> from >> tableName;
-                    vector<string> conditions;
-                    string condition;
-                    if (iss >> where) {
-                        while (iss >> condition) {
-                            if(condition.front()=='\''&&condition.back()!='\'')
-                            {
-                                string next_item;
-                                while(iss>>next_item)
-                                {
-                                    if(next_item.back()=='\'')
-                                    {
-                                        condition=condition+" "+next_item;
-                                        break;
-                                    }
-                                    condition=condition+" " +next_item;
-                                }
-                            }
-                            conditions.push_back(condition);
-                        }
-                    }
-                    db.deleteFromTable(tableName, conditions);
+                    queue.push(sqlCommand, lineNum);
                 }
-            } catch (const exception& e) {
-                cerr << "Error at line " << lineNum << ": " << e.what() << endl;
-                cerr << "Command: " << sqlCommand << endl;
-            }
             sqlCommand.clear();//清空sql命令
             }
             pos=semicolonPos+1;//更新位置到分号后（不用再去掉分号）
@@ -1073,13 +6683,512 @@ void executeSQL(const string& filename, const string& outputFile, MiniDB& db)
             }
         }
     }
+}
+
+void executeSQL(const string& filename, const string& outputFile, MiniDB& db, size_t threads = 1)
+{
+    // ****首先清空输出文件****
+    ofstream clearFile(outputFile, ios::trunc);
+    clearFile.close();
+
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Unable to open file: " << filename << endl;
+        return;
+    }
+
+    // 读脚本和执行语句流水线进行: 读线程切分后面的语句时, 当前线程执行并保存前面的语句
+    StatementQueue queue(PIPELINE_DEPTH);
+    thread reader([&] {
+        readScript(file, queue);
+        queue.close();
+    });
+
+    if(threads > 1) {
+        executeParallel(queue, outputFile, db, threads);
+    } else {
+        vector<SelectQuery> group;  // 连续的同表SELECT, 遇到别的语句或别的表时一起执行
+        pair<string,int> statement;
+        while(queue.pop(statement)) {
+            submitStatement(group, statement.first, statement.second, outputFile, db);
+        }
+        executeSelectGroup(group, outputFile, db);
+    }
+    reader.join();
     file.close();//记住关闭文件（
 }
 
+//********** 嵌入接口(minidb.h) **********
+//连接持有一个MiniDB; 预编译语句只解析一次, 执行时把绑定的字面量填进参数位置; 查询结果按列类型收集, 由游标逐行读取
+
+namespace minidb {
+
+struct Connection::Session {
+    MiniDB db;
+    int statements = 0;  // 已执行的语句数, 作为报错中的行号
+};
+
+struct Cursor::Result {
+    MiniDB::ResultSet set;
+};
+
+struct PreparedStatement::Plan {
+    shared_ptr<Connection::Session> session;
+    string sql;
+    size_t parameters = 0;
+    enum class Kind { SELECT, JOIN, OTHER } kind = Kind::OTHER;
+    SelectQuery select;
+    JoinQuery join;
+    vector<size_t> slots;   // SELECT/INNER JOIN: 第i个参数是conditions中的第slots[i]项
+    vector<string> pieces;  // 其他语句: SQL在参数处切开的片段, 比参数多一个
+};
+
+namespace {
+
+//在当前线程执行fn: 引擎写到cerr的报错收集起来, 连同抛出的异常一起以Error抛出
+template<typename Fn>
+void checked(Fn fn)
+{
+    static ThreadRoutedBuf routed(cerr.rdbuf());
+    static bool installed = (cerr.rdbuf(&routed), true);
+    (void)installed;
+    string errors;
+    ThreadRoutedBuf::target = &errors;
+    try {
+        fn();
+    } catch (const exception& e) {
+        errors += e.what();
+    }
+    ThreadRoutedBuf::target = nullptr;
+    while(!errors.empty() && errors.back() == '\n') errors.pop_back();
+    if(!errors.empty()) {
+        throw Error(errors);
+    }
+}
+
+//SQL中引号外的?的位置
+vector<size_t> placeholders(const string& sql)
+{
+    vector<size_t> positions;
+    bool inQuotes = false;
+    for(size_t i = 0; i < sql.size(); ++i) {
+        if(sql[i] == '\'') inQuotes = !inQuotes;
+        else if(sql[i] == '?' && !inQuotes) positions.push_back(i);
+    }
+    return positions;
+}
+
+}  // namespace
+
+Cursor::Cursor(shared_ptr<Result> result) : result(std::move(result)) {}
+
+bool Cursor::next()
+{
+    size_t rows = result->set.rows.size();
+    if(position < rows) {
+        ++position;
+        return true;
+    }
+    position = rows + 1;
+    return false;
+}
+
+size_t Cursor::columnCount() const
+{
+    return result->set.names.size();
+}
+
+const string& Cursor::columnName(size_t col) const
+{
+    if(col >= columnCount()) throw Error("Column index out of range");
+    return result->set.names[col];
+}
+
+Type Cursor::columnType(size_t col) const
+{
+    if(col >= columnCount()) throw Error("Column index out of range");
+    const string& type = result->set.types[col];
+    char kind = columnKind(type);
+    return kind == 'I' ? Type::Integer : kind == 'F' || kind == 'D' ? Type::Float : Type::Text;
+}
+
+int64_t Cursor::getInteger(size_t col) const
+{
+    if(columnType(col) != Type::Integer) throw Error("Column " + columnName(col) + " is not INTEGER");
+    if(position == 0 || position > result->set.rows.size()) throw Error("Cursor is not on a row");
+    return result->set.rows.integer(position - 1, col);
+}
+
+double Cursor::getFloat(size_t col) const
+{
+    Type type = columnType(col);
+    if(type == Type::Text) throw Error("Column " + columnName(col) + " is not numeric");
+    if(position == 0 || position > result->set.rows.size()) throw Error("Cursor is not on a row");
+    if(type == Type::Integer) return static_cast<double>(result->set.rows.integer(position - 1, col));
+    string text = result->set.rows.get(position - 1, col);  // DECIMAL按规范写法格式化
+    return text.empty() ? 0 : stod(text);
+}
+
+string Cursor::getText(size_t col) const
+{
+    Type type = columnType(col);
+    if(position == 0 || position > result->set.rows.size()) throw Error("Cursor is not on a row");
+    string text = result->set.rows.get(position - 1, col);
+    if(type == Type::Text && text.size() >= 2 && text.front() == '\'' && text.back() == '\'') {
+        text = text.substr(1, text.size() - 2);
+    }
+    return text;
+}
+
+PreparedStatement::PreparedStatement(shared_ptr<Plan> plan) : plan(std::move(plan)), values(this->plan->parameters) {}
+
+size_t PreparedStatement::parameterCount() const
+{
+    return plan->parameters;
+}
+
+PreparedStatement& PreparedStatement::bind(size_t index, int64_t value)
+{
+    if(index == 0 || index > values.size()) throw Error("Parameter index out of range");
+    values[index - 1] = to_string(value);
+    return *this;
+}
+
+PreparedStatement& PreparedStatement::bind(size_t index, double value)
+{
+    if(index == 0 || index > values.size()) throw Error("Parameter index out of range");
+    char buffer[32];
+    auto written = to_chars(buffer, buffer + sizeof(buffer), value);  // 最短的能精确还原的写法
+    values[index - 1] = string(buffer, written.ptr);
+    return *this;
+}
+
+PreparedStatement& PreparedStatement::bind(size_t index, const string& value)
+{
+    if(index == 0 || index > values.size()) throw Error("Parameter index out of range");
+    if(value.find('\'') != string::npos) throw Error("TEXT parameter cannot contain a single quote");
+    values[index - 1] = "'" + value + "'";
+    return *this;
+}
+
+void PreparedStatement::clearBindings()
+{
+    for(auto& value : values) value.clear();
+}
+
+void PreparedStatement::execute()
+{
+    if(plan->kind != Plan::Kind::OTHER) {
+        query();
+        return;
+    }
+    string sql = plan->pieces[0];
+    for(size_t i = 0; i < values.size(); ++i) {
+        if(values[i].empty()) throw Error("Parameter " + to_string(i + 1) + " is not bound");
+        sql += values[i] + plan->pieces[i + 1];
+    }
+    Connection::Session& session = *plan->session;
+    stringbuf discarded;  // EXPLAIN等写给结果文件的输出
+    MiniDB::outputBuffer = &discarded;
+    try {
+        checked([&] { executeStatement(sql, "", session.db, ++session.statements); });
+    } catch (...) {
+        MiniDB::outputBuffer = nullptr;
+        throw;
+    }
+    MiniDB::outputBuffer = nullptr;
+}
+
+Cursor PreparedStatement::query()
+{
+    if(plan->kind == Plan::Kind::OTHER) throw Error("query() needs a SELECT statement");
+    for(size_t i = 0; i < values.size(); ++i) {
+        if(values[i].empty()) throw Error("Parameter " + to_string(i + 1) + " is not bound");
+    }
+    MiniDB& db = plan->session->db;
+    plan->session->statements++;
+    auto result = make_shared<Cursor::Result>();
+    MiniDB::collect = &result->set;
+    try {
+        checked([&] {
+            if(plan->kind == Plan::Kind::SELECT) {
+                vector<string> conditions = plan->select.conditions;
+                for(size_t i = 0; i < values.size(); ++i) conditions[plan->slots[i]] = values[i];
+                db.select_to_file(plan->select.table, plan->select.columns, conditions, "");
+            } else {
+                vector<string> conditions = plan->join.conditions;
+                for(size_t i = 0; i < values.size(); ++i) conditions[plan->slots[i]] = values[i];
+                db.inner_join_file(plan->join.tables, plan->join.columns, conditions, "");
+            }
+        });
+    } catch (...) {
+        MiniDB::collect = nullptr;
+        throw;
+    }
+    MiniDB::collect = nullptr;
+    return Cursor(result);
+}
+
+Connection::Connection() : session(make_shared<Session>()) {}
+
+Connection::~Connection() = default;
+
+void Connection::execute(const string& sql)
+{
+    prepare(sql).execute();
+}
+
+Cursor Connection::query(const string& sql)
+{
+    return prepare(sql).query();
+}
+
+//解析一次: SELECT和INNER JOIN解析成查询结构, 参数只能是WHERE条件的值; 其他语句在参数处切开, 执行时拼回完整的SQL
+PreparedStatement Connection::prepare(const string& sql)
+{
+    auto plan = make_shared<PreparedStatement::Plan>();
+    plan->session = session;
+    plan->sql = trim(sql);
+    if(!plan->sql.empty() && plan->sql.back() == ';') plan->sql = trim(plan->sql.substr(0, plan->sql.size() - 1));
+    vector<size_t> positions = placeholders(plan->sql);
+    plan->parameters = positions.size();
+
+    istringstream iss(plan->sql);
+    string command;
+    iss >> command;
+    if(command == "SELECT") {
+        vector<string>* conditions;
+        size_t first = 0;  // conditions中WHERE条件的起点
+        if(plan->sql.find("INNER JOIN") != string::npos) {
+            plan->kind = PreparedStatement::Plan::Kind::JOIN;
+            parseJoin(iss, plan->sql, plan->join);
+            conditions = &plan->join.conditions;
+            first = 2 * (plan->join.tables.size() - 1);
+        } else {
+            plan->kind = PreparedStatement::Plan::Kind::SELECT;
+            parseSelect(iss, session->db, plan->select);
+            conditions = &plan->select.conditions;
+        }
+        for(size_t i = first; i < conditions->size(); ++i) {
+            if((*conditions)[i] == "?") plan->slots.push_back(i);
+        }
+        if(plan->slots.size() != plan->parameters) {
+            throw Error("In a SELECT, parameters can only be WHERE values");
+        }
+    } else {
+        size_t start = 0;
+        for(size_t pos : positions) {
+            plan->pieces.push_back(plan->sql.substr(start, pos - start));
+            start = pos + 1;
+        }
+        plan->pieces.push_back(plan->sql.substr(start));
+    }
+    return PreparedStatement(plan);
+}
+
+}  // namespace minidb
+
+#ifndef MINIDB_LIBRARY
+//********** 基准测试 **********
+//确定性的student/enrollment数据生成器 + 各类语句的延迟统计, 结果输出为JSON
+
+//一类操作的计时结果
+struct BenchResult {
+    string name;
+    size_t rowsPerOp = 0;  // 每次操作涉及的表行数, 用于计算行吞吐
+    vector<double> latenciesMs;
+};
+
+static double percentile(vector<double> values, double p) {
+    if (values.empty()) return 0;
+    sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(p / 100.0 * values.size() + 0.999999);
+    return values[min(values.size(), max<size_t>(rank, 1)) - 1];
+}
+
+//mt19937的输出序列由标准规定, 只用它的原始输出(不用分布类), 保证各平台生成相同数据
+static uint32_t benchRand(mt19937& rng, uint32_t bound) {
+    return static_cast<uint32_t>(rng() % bound);
+}
+
+static const char* const BENCH_MAJORS[] = {"Microelectronics", "Data Science", "Financial Technology", "Civil Engineering", "Vocaloid", "Cakewalk Producer", "Mathematics", "Physics"};
+static const char* const BENCH_COURSES[] = {"Microelectronics", "Data Science", "Machine Learning", "Financial technology", "Mapping Engineering", "Unknown Mother Goose", "Melt", "ODDS&ENDS"};
+
+static vector<string> benchStudent(mt19937& rng, size_t id) {
+    uint32_t gpa = benchRand(rng, 401);
+    return {to_string(id), "'Student " + to_string(id) + "'",
+            to_string(gpa / 100) + "." + (gpa % 100 < 10 ? "0" : "") + to_string(gpa % 100),
+            string("'") + BENCH_MAJORS[benchRand(rng, 8)] + "'"};
+}
+
+//生成student(rows行, ID从1000开始连续)和enrollment(2*rows行)
+static void generateUniversity(MiniDB& db, const string& dbName, size_t rows, mt19937& rng, const string& outputFile) {
+    db.create_database(dbName);
+    db.use_database(dbName);
+    executeStatement("CREATE TABLE student ( ID INTEGER, Name TEXT, GPA FLOAT, Major TEXT )", outputFile, db, 0);
+    executeStatement("CREATE TABLE enrollment ( StudentID INTEGER, Course TEXT )", outputFile, db, 0);
+    auto& student = *db.currentDatabase->tables["student"];
+    auto& enrollment = *db.currentDatabase->tables["enrollment"];
+    for (size_t i = 0; i < rows; ++i) {
+        student.append(benchStudent(rng, 1000 + i));
+    }
+    for (size_t i = 0; i < 2 * rows; ++i) {
+        enrollment.append({to_string(1000 + benchRand(rng, static_cast<uint32_t>(rows))),
+                           string("'") + BENCH_COURSES[benchRand(rng, 8)] + "'"});
+    }
+    db.save_database(*db.currentDatabase);
+}
+
+template<typename Fn>
+static double timeMs(Fn fn) {
+    auto start = chrono::steady_clock::now();
+    fn();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+//对一种数据规模跑完整的一轮: USE/查询/连接/插入/更新/删除/保存
+static vector<BenchResult> benchOneSize(size_t rows, uint32_t seed, size_t bufferPages) {
+    mt19937 rng(seed);
+    string dbName = "bench_" + to_string(rows);
+    string outputFile = dbName + "_output.csv";
+    vector<BenchResult> results;
+    uint32_t n = static_cast<uint32_t>(rows);
+
+    {
+        MiniDB gen;
+        gen.bufferPool.setCapacity(bufferPages);
+        BenchResult r{"generate", 3 * rows, {}};
+        r.latenciesMs.push_back(timeMs([&] { generateUniversity(gen, dbName, rows, rng, outputFile); }));
+        results.push_back(r);
+    }
+
+    MiniDB db;
+    db.bufferPool.setCapacity(bufferPages);
+    db.resultCache.setCapacity(0);  // 测的是执行本身, 重复的语句不走缓存
+    auto run = [&](BenchResult& r, const string& sql) {
+        ofstream(outputFile, ios::trunc).close();
+        db.isprint = false;
+        r.latenciesMs.push_back(timeMs([&] { executeStatement(sql, outputFile, db, 0); }));
+    };
+
+    BenchResult use{"use_load", 3 * rows, {}};
+    for (int i = 0; i < 5; ++i) run(use, "USE DATABASE " + dbName);
+    results.push_back(use);
+
+    BenchResult select{"select_filtered", rows, {}};
+    for (int i = 0; i < 10; ++i) {
+        run(select, "SELECT ID, Name, GPA FROM student WHERE GPA > 3." + to_string(90 + i) + " OR Major = 'Vocaloid'");
+        run(select, "SELECT ID, Name, GPA FROM student WHERE ID = " + to_string(1000 + benchRand(rng, n)));
+    }
+    results.push_back(select);
+
+    BenchResult join{"inner_join", 3 * rows, {}};
+    for (int i = 0; i < 3; ++i) {
+        run(join, "SELECT student.Name, enrollment.Course FROM student INNER JOIN enrollment ON student.ID = enrollment.StudentID WHERE student.ID < " + to_string(1000 + max<size_t>(rows / 100, 1)));
+    }
+    results.push_back(join);
+
+    BenchResult insert{"insert", rows, {}};
+    size_t inserts = min<size_t>(rows, 1000);
+    for (size_t i = 0; i < inserts; ++i) {
+        auto values = benchStudent(rng, 1000 + rows + i);
+        run(insert, "INSERT INTO student VALUES (" + values[0] + ", " + values[1] + ", " + values[2] + ", " + values[3] + ")");
+    }
+    results.push_back(insert);
+
+    BenchResult update{"update_expression", rows, {}};
+    for (int i = 0; i < 20; ++i) {
+        run(update, "UPDATE student SET GPA = (GPA - 0.1) * 0.95 WHERE ID = " + to_string(1000 + benchRand(rng, n)));
+    }
+    results.push_back(update);
+
+    BenchResult del{"delete", rows, {}};
+    for (int i = 0; i < 20; ++i) {
+        run(del, "DELETE FROM student WHERE ID = " + to_string(1000 + benchRand(rng, n)));
+    }
+    results.push_back(del);
+
+    BenchResult save{"save", 3 * rows, {}};
+    for (int i = 0; i < 5; ++i) {
+        save.latenciesMs.push_back(timeMs([&] { db.save_database(*db.currentDatabase); }));
+    }
+    results.push_back(save);
+
+    // 清理生成的文件
+    db.bufferPool.discard(db.currentDatabase->pageFile("student"));
+    db.bufferPool.discard(db.currentDatabase->pageFile("enrollment"));
+    for (const char* table : {"student", "enrollment"}) {
+        remove(db.currentDatabase->pageFile(table).c_str());
+        remove(db.currentDatabase->zoneFile(table).c_str());
+        remove(db.currentDatabase->overflowFile(table).c_str());
+    }
+    remove((dbName + ".db").c_str());
+    remove(outputFile.c_str());
+    return results;
+}
+
+static void runBenchmark(const vector<size_t>& sizes, uint32_t seed, size_t bufferPages, ostream& out) {
+    out << fixed << setprecision(3);
+    out << "{\n  \"benchmark\": \"minidb\",\n  \"seed\": " << seed << ",\n  \"buffer_pool_pages\": " << bufferPages << ",\n  \"results\": [";
+    for (size_t s = 0; s < sizes.size(); ++s) {
+        auto results = benchOneSize(sizes[s], seed, bufferPages);
+        out << (s ? "," : "") << "\n    {\"rows\": " << sizes[s] << ", \"operations\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            double total = 0;
+            for (double ms : r.latenciesMs) total += ms;
+            double seconds = max(total / 1000.0, 1e-9);
+            out << (i ? "," : "") << "\n      {\"name\": \"" << r.name << "\", \"count\": " << r.latenciesMs.size()
+                << ", \"total_ms\": " << total
+                << ", \"ops_per_s\": " << r.latenciesMs.size() / seconds
+                << ", \"rows_per_s\": " << r.latenciesMs.size() * r.rowsPerOp / seconds
+                << ", \"p50_ms\": " << percentile(r.latenciesMs, 50)
+                << ", \"p99_ms\": " << percentile(r.latenciesMs, 99) << "}";
+        }
+        out << "\n    ]}";
+        out.flush();
+    }
+    out << "\n  ]\n}\n";
+}
+
 int main(int argc, char* argv[])
 {
-    if (argc != 3) {
-        std::cerr << "Usage: " << argv[0] << " <input.sql> <output.csv>" << std::endl;
+    //基准测试模式: minidb --bench [--rows 1000,10000,100000] [--seed N] [--out report.json] [--buffer-pool N]
+    if (argc >= 2 && std::string(argv[1]) == "--bench") {
+        std::vector<size_t> sizes = {1000, 10000, 100000};
+        uint32_t seed = 42;
+        size_t bufferPages = 256;
+        std::string reportFile;
+        for (int i = 2; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--rows" && i + 1 < argc) {
+                sizes.clear();
+                std::istringstream list(argv[++i]);
+                std::string item;
+                while (std::getline(list, item, ',')) sizes.push_back(std::stoul(item));
+            } else if (option == "--seed" && i + 1 < argc) {
+                seed = static_cast<uint32_t>(std::stoul(argv[++i]));
+            } else if (option == "--out" && i + 1 < argc) {
+                reportFile = argv[++i];
+            } else if (option == "--buffer-pool" && i + 1 < argc) {
+                bufferPages = std::stoul(argv[++i]);
+            } else {
+                std::cerr << "Unknown option: " << option << std::endl;
+                return 1;
+            }
+        }
+        if (reportFile.empty()) {
+            runBenchmark(sizes, seed, bufferPages, std::cout);
+        } else {
+            std::ofstream report(reportFile);
+            runBenchmark(sizes, seed, bufferPages, report);
+        }
+        return 0;
+    }
+
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.sql> <output.csv> [--buffer-pool <pages>] [--result-cache <MB>] [--threads <n>] [--memory-limit <MB>] [--query-memory-limit <MB>] [--profile]" << std::endl;
+        std::cerr << "       " << argv[0] << " --bench [--rows <n,n,...>] [--seed <n>] [--out <report.json>] [--buffer-pool <pages>]" << std::endl;
         return 1;
     }
 
@@ -1087,7 +7196,43 @@ int main(int argc, char* argv[])
     std::string outputFile = argv[2];   //输出的csv文件
 
     MiniDB db;  //****每次进入函数时进行操作的db****
-    executeSQL(inputFile, outputFile, db);
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 3; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--buffer-pool" && i + 1 < argc) {
+            db.bufferPool.setCapacity(std::stoul(argv[++i]));  //缓冲池页数
+        } else if (option == "--result-cache" && i + 1 < argc) {
+            db.resultCache.setCapacity(std::stoul(argv[++i]) << 20);  //结果缓存MB数, 0为关闭
+        } else if (option == "--threads" && i + 1 < argc) {
+            threads = std::max<size_t>(1, std::stoul(argv[++i]));  //并行执行语句的线程数, 1为逐条执行
+        } else if (option == "--memory-limit" && i + 1 < argc) {
+            db.memory.globalLimit = static_cast<size_t>(std::stod(argv[++i]) * (1 << 20));  //所有表和语句合计的内存MB数, 0为不限
+        } else if (option == "--query-memory-limit" && i + 1 < argc) {
+            db.memory.queryLimit = static_cast<size_t>(std::stod(argv[++i]) * (1 << 20));  //每条语句工作内存的MB数, 0为不限
+        } else if (option == "--profile") {
+            db.profiler.enabled = true;  //结束时输出汇总表和trace文件
+        } else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+    // 每个线程同时最多钉住一页, 线程数不超过缓冲池页数; 剖析按语句顺序记录, 只能逐条执行
+    threads = std::min(threads, db.bufferPool.getCapacity());
+    if (db.profiler.enabled) threads = 1;
+    // 分区表的并行读线程用执行线程之外剩下的缓冲池页
+    db.scanThreads = threads;
+    db.scanSlots = db.bufferPool.getCapacity() - threads;
+    executeSQL(inputFile, outputFile, db, threads);
+
+    if (db.profiler.enabled) {
+        std::string traceFile = outputFile + ".trace.json";
+        db.profiler.writeSummary(std::cout);
+        db.resultCache.writeSummary(std::cout);
+        db.memory.writeSummary(std::cout);
+        db.profiler.writeTrace(traceFile);
+        std::cout << "trace written to " << traceFile << std::endl;
+    }
 
     return 0;
-}
\ No newline at end of file
+}
+#endif
@@ -0,0 +1,1143 @@
+CREATE DATABASE decimal_join;
+USE DATABASE decimal_join;
+CREATE TABLE a (
+id INTEGER,
+name TEXT
+);
+CREATE TABLE b (
+k DECIMAL(5,2),
+tag TEXT
+);
+CREATE TABLE c (
+v DECIMAL(6,1),
+note TEXT
+);
+INSERT INTO a VALUES (1, 'one');
+INSERT INTO a VALUES (2, 'two');
+INSERT INTO a VALUES (3, 'three');
+INSERT INTO b VALUES (1.00, 'b-1');
+INSERT INTO b VALUES (2.50, 'b-2.5');
+INSERT INTO b VALUES (3.00, 'b-3');
+INSERT INTO b VALUES (3.01, 'b-3.01');
+INSERT INTO c VALUES (2.5, 'c-2.5');
+INSERT INTO c VALUES (3, 'c-3');
+INSERT INTO c VALUES (1.1, 'c-1.1');
+CREATE TABLE big_a (
+id INTEGER,
+name TEXT
+);
+CREATE TABLE big_b (
+k DECIMAL(8,2),
+tag TEXT
+);
+INSERT INTO big_a VALUES (1, 'a1');
+INSERT INTO big_a VALUES (2, 'a2');
+INSERT INTO big_a VALUES (3, 'a3');
+INSERT INTO big_a VALUES (4, 'a4');
+INSERT INTO big_a VALUES (5, 'a5');
+INSERT INTO big_a VALUES (6, 'a6');
+INSERT INTO big_a VALUES (7, 'a7');
+INSERT INTO big_a VALUES (8, 'a8');
+INSERT INTO big_a VALUES (9, 'a9');
+INSERT INTO big_a VALUES (10, 'a10');
+INSERT INTO big_a VALUES (11, 'a11');
+INSERT INTO big_a VALUES (12, 'a12');
+INSERT INTO big_a VALUES (13, 'a13');
+INSERT INTO big_a VALUES (14, 'a14');
+INSERT INTO big_a VALUES (15, 'a15');
+INSERT INTO big_a VALUES (16, 'a16');
+INSERT INTO big_a VALUES (17, 'a17');
+INSERT INTO big_a VALUES (18, 'a18');
+INSERT INTO big_a VALUES (19, 'a19');
+INSERT INTO big_a VALUES (20, 'a20');
+INSERT INTO big_a VALUES (21, 'a21');
+INSERT INTO big_a VALUES (22, 'a22');
+INSERT INTO big_a VALUES (23, 'a23');
+INSERT INTO big_a VALUES (24, 'a24');
+INSERT INTO big_a VALUES (25, 'a25');
+INSERT INTO big_a VALUES (26, 'a26');
+INSERT INTO big_a VALUES (27, 'a27');
+INSERT INTO big_a VALUES (28, 'a28');
+INSERT INTO big_a VALUES (29, 'a29');
+INSERT INTO big_a VALUES (30, 'a30');
+INSERT INTO big_a VALUES (31, 'a31');
+INSERT INTO big_a VALUES (32, 'a32');
+INSERT INTO big_a VALUES (33, 'a33');
+INSERT INTO big_a VALUES (34, 'a34');
+INSERT INTO big_a VALUES (35, 'a35');
+INSERT INTO big_a VALUES (36, 'a36');
+INSERT INTO big_a VALUES (37, 'a37');
+INSERT INTO big_a VALUES (38, 'a38');
+INSERT INTO big_a VALUES (39, 'a39');
+INSERT INTO big_a VALUES (40, 'a40');
+INSERT INTO big_a VALUES (41, 'a41');
+INSERT INTO big_a VALUES (42, 'a42');
+INSERT INTO big_a VALUES (43, 'a43');
+INSERT INTO big_a VALUES (44, 'a44');
+INSERT INTO big_a VALUES (45, 'a45');
+INSERT INTO big_a VALUES (46, 'a46');
+INSERT INTO big_a VALUES (47, 'a47');
+INSERT INTO big_a VALUES (48, 'a48');
+INSERT INTO big_a VALUES (49, 'a49');
+INSERT INTO big_a VALUES (50, 'a50');
+INSERT INTO big_a VALUES (51, 'a51');
+INSERT INTO big_a VALUES (52, 'a52');
+INSERT INTO big_a VALUES (53, 'a53');
+INSERT INTO big_a VALUES (54, 'a54');
+INSERT INTO big_a VALUES (55, 'a55');
+INSERT INTO big_a VALUES (56, 'a56');
+INSERT INTO big_a VALUES (57, 'a57');
+INSERT INTO big_a VALUES (58, 'a58');
+INSERT INTO big_a VALUES (59, 'a59');
+INSERT INTO big_a VALUES (60, 'a60');
+INSERT INTO big_a VALUES (61, 'a61');
+INSERT INTO big_a VALUES (62, 'a62');
+INSERT INTO big_a VALUES (63, 'a63');
+INSERT INTO big_a VALUES (64, 'a64');
+INSERT INTO big_a VALUES (65, 'a65');
+INSERT INTO big_a VALUES (66, 'a66');
+INSERT INTO big_a VALUES (67, 'a67');
+INSERT INTO big_a VALUES (68, 'a68');
+INSERT INTO big_a VALUES (69, 'a69');
+INSERT INTO big_a VALUES (70, 'a70');
+INSERT INTO big_a VALUES (71, 'a71');
+INSERT INTO big_a VALUES (72, 'a72');
+INSERT INTO big_a VALUES (73, 'a73');
+INSERT INTO big_a VALUES (74, 'a74');
+INSERT INTO big_a VALUES (75, 'a75');
+INSERT INTO big_a VALUES (76, 'a76');
+INSERT INTO big_a VALUES (77, 'a77');
+INSERT INTO big_a VALUES (78, 'a78');
+INSERT INTO big_a VALUES (79, 'a79');
+INSERT INTO big_a VALUES (80, 'a80');
+INSERT INTO big_a VALUES (81, 'a81');
+INSERT INTO big_a VALUES (82, 'a82');
+INSERT INTO big_a VALUES (83, 'a83');
+INSERT INTO big_a VALUES (84, 'a84');
+INSERT INTO big_a VALUES (85, 'a85');
+INSERT INTO big_a VALUES (86, 'a86');
+INSERT INTO big_a VALUES (87, 'a87');
+INSERT INTO big_a VALUES (88, 'a88');
+INSERT INTO big_a VALUES (89, 'a89');
+INSERT INTO big_a VALUES (90, 'a90');
+INSERT INTO big_a VALUES (91, 'a91');
+INSERT INTO big_a VALUES (92, 'a92');
+INSERT INTO big_a VALUES (93, 'a93');
+INSERT INTO big_a VALUES (94, 'a94');
+INSERT INTO big_a VALUES (95, 'a95');
+INSERT INTO big_a VALUES (96, 'a96');
+INSERT INTO big_a VALUES (97, 'a97');
+INSERT INTO big_a VALUES (98, 'a98');
+INSERT INTO big_a VALUES (99, 'a99');
+INSERT INTO big_a VALUES (100, 'a100');
+INSERT INTO big_a VALUES (101, 'a101');
+INSERT INTO big_a VALUES (102, 'a102');
+INSERT INTO big_a VALUES (103, 'a103');
+INSERT INTO big_a VALUES (104, 'a104');
+INSERT INTO big_a VALUES (105, 'a105');
+INSERT INTO big_a VALUES (106, 'a106');
+INSERT INTO big_a VALUES (107, 'a107');
+INSERT INTO big_a VALUES (108, 'a108');
+INSERT INTO big_a VALUES (109, 'a109');
+INSERT INTO big_a VALUES (110, 'a110');
+INSERT INTO big_a VALUES (111, 'a111');
+INSERT INTO big_a VALUES (112, 'a112');
+INSERT INTO big_a VALUES (113, 'a113');
+INSERT INTO big_a VALUES (114, 'a114');
+INSERT INTO big_a VALUES (115, 'a115');
+INSERT INTO big_a VALUES (116, 'a116');
+INSERT INTO big_a VALUES (117, 'a117');
+INSERT INTO big_a VALUES (118, 'a118');
+INSERT INTO big_a VALUES (119, 'a119');
+INSERT INTO big_a VALUES (120, 'a120');
+INSERT INTO big_a VALUES (121, 'a121');
+INSERT INTO big_a VALUES (122, 'a122');
+INSERT INTO big_a VALUES (123, 'a123');
+INSERT INTO big_a VALUES (124, 'a124');
+INSERT INTO big_a VALUES (125, 'a125');
+INSERT INTO big_a VALUES (126, 'a126');
+INSERT INTO big_a VALUES (127, 'a127');
+INSERT INTO big_a VALUES (128, 'a128');
+INSERT INTO big_a VALUES (129, 'a129');
+INSERT INTO big_a VALUES (130, 'a130');
+INSERT INTO big_a VALUES (131, 'a131');
+INSERT INTO big_a VALUES (132, 'a132');
+INSERT INTO big_a VALUES (133, 'a133');
+INSERT INTO big_a VALUES (134, 'a134');
+INSERT INTO big_a VALUES (135, 'a135');
+INSERT INTO big_a VALUES (136, 'a136');
+INSERT INTO big_a VALUES (137, 'a137');
+INSERT INTO big_a VALUES (138, 'a138');
+INSERT INTO big_a VALUES (139, 'a139');
+INSERT INTO big_a VALUES (140, 'a140');
+INSERT INTO big_a VALUES (141, 'a141');
+INSERT INTO big_a VALUES (142, 'a142');
+INSERT INTO big_a VALUES (143, 'a143');
+INSERT INTO big_a VALUES (144, 'a144');
+INSERT INTO big_a VALUES (145, 'a145');
+INSERT INTO big_a VALUES (146, 'a146');
+INSERT INTO big_a VALUES (147, 'a147');
+INSERT INTO big_a VALUES (148, 'a148');
+INSERT INTO big_a VALUES (149, 'a149');
+INSERT INTO big_a VALUES (150, 'a150');
+INSERT INTO big_a VALUES (151, 'a151');
+INSERT INTO big_a VALUES (152, 'a152');
+INSERT INTO big_a VALUES (153, 'a153');
+INSERT INTO big_a VALUES (154, 'a154');
+INSERT INTO big_a VALUES (155, 'a155');
+INSERT INTO big_a VALUES (156, 'a156');
+INSERT INTO big_a VALUES (157, 'a157');
+INSERT INTO big_a VALUES (158, 'a158');
+INSERT INTO big_a VALUES (159, 'a159');
+INSERT INTO big_a VALUES (160, 'a160');
+INSERT INTO big_a VALUES (161, 'a161');
+INSERT INTO big_a VALUES (162, 'a162');
+INSERT INTO big_a VALUES (163, 'a163');
+INSERT INTO big_a VALUES (164, 'a164');
+INSERT INTO big_a VALUES (165, 'a165');
+INSERT INTO big_a VALUES (166, 'a166');
+INSERT INTO big_a VALUES (167, 'a167');
+INSERT INTO big_a VALUES (168, 'a168');
+INSERT INTO big_a VALUES (169, 'a169');
+INSERT INTO big_a VALUES (170, 'a170');
+INSERT INTO big_a VALUES (171, 'a171');
+INSERT INTO big_a VALUES (172, 'a172');
+INSERT INTO big_a VALUES (173, 'a173');
+INSERT INTO big_a VALUES (174, 'a174');
+INSERT INTO big_a VALUES (175, 'a175');
+INSERT INTO big_a VALUES (176, 'a176');
+INSERT INTO big_a VALUES (177, 'a177');
+INSERT INTO big_a VALUES (178, 'a178');
+INSERT INTO big_a VALUES (179, 'a179');
+INSERT INTO big_a VALUES (180, 'a180');
+INSERT INTO big_a VALUES (181, 'a181');
+INSERT INTO big_a VALUES (182, 'a182');
+INSERT INTO big_a VALUES (183, 'a183');
+INSERT INTO big_a VALUES (184, 'a184');
+INSERT INTO big_a VALUES (185, 'a185');
+INSERT INTO big_a VALUES (186, 'a186');
+INSERT INTO big_a VALUES (187, 'a187');
+INSERT INTO big_a VALUES (188, 'a188');
+INSERT INTO big_a VALUES (189, 'a189');
+INSERT INTO big_a VALUES (190, 'a190');
+INSERT INTO big_a VALUES (191, 'a191');
+INSERT INTO big_a VALUES (192, 'a192');
+INSERT INTO big_a VALUES (193, 'a193');
+INSERT INTO big_a VALUES (194, 'a194');
+INSERT INTO big_a VALUES (195, 'a195');
+INSERT INTO big_a VALUES (196, 'a196');
+INSERT INTO big_a VALUES (197, 'a197');
+INSERT INTO big_a VALUES (198, 'a198');
+INSERT INTO big_a VALUES (199, 'a199');
+INSERT INTO big_a VALUES (200, 'a200');
+INSERT INTO big_a VALUES (201, 'a201');
+INSERT INTO big_a VALUES (202, 'a202');
+INSERT INTO big_a VALUES (203, 'a203');
+INSERT INTO big_a VALUES (204, 'a204');
+INSERT INTO big_a VALUES (205, 'a205');
+INSERT INTO big_a VALUES (206, 'a206');
+INSERT INTO big_a VALUES (207, 'a207');
+INSERT INTO big_a VALUES (208, 'a208');
+INSERT INTO big_a VALUES (209, 'a209');
+INSERT INTO big_a VALUES (210, 'a210');
+INSERT INTO big_a VALUES (211, 'a211');
+INSERT INTO big_a VALUES (212, 'a212');
+INSERT INTO big_a VALUES (213, 'a213');
+INSERT INTO big_a VALUES (214, 'a214');
+INSERT INTO big_a VALUES (215, 'a215');
+INSERT INTO big_a VALUES (216, 'a216');
+INSERT INTO big_a VALUES (217, 'a217');
+INSERT INTO big_a VALUES (218, 'a218');
+INSERT INTO big_a VALUES (219, 'a219');
+INSERT INTO big_a VALUES (220, 'a220');
+INSERT INTO big_a VALUES (221, 'a221');
+INSERT INTO big_a VALUES (222, 'a222');
+INSERT INTO big_a VALUES (223, 'a223');
+INSERT INTO big_a VALUES (224, 'a224');
+INSERT INTO big_a VALUES (225, 'a225');
+INSERT INTO big_a VALUES (226, 'a226');
+INSERT INTO big_a VALUES (227, 'a227');
+INSERT INTO big_a VALUES (228, 'a228');
+INSERT INTO big_a VALUES (229, 'a229');
+INSERT INTO big_a VALUES (230, 'a230');
+INSERT INTO big_a VALUES (231, 'a231');
+INSERT INTO big_a VALUES (232, 'a232');
+INSERT INTO big_a VALUES (233, 'a233');
+INSERT INTO big_a VALUES (234, 'a234');
+INSERT INTO big_a VALUES (235, 'a235');
+INSERT INTO big_a VALUES (236, 'a236');
+INSERT INTO big_a VALUES (237, 'a237');
+INSERT INTO big_a VALUES (238, 'a238');
+INSERT INTO big_a VALUES (239, 'a239');
+INSERT INTO big_a VALUES (240, 'a240');
+INSERT INTO big_a VALUES (241, 'a241');
+INSERT INTO big_a VALUES (242, 'a242');
+INSERT INTO big_a VALUES (243, 'a243');
+INSERT INTO big_a VALUES (244, 'a244');
+INSERT INTO big_a VALUES (245, 'a245');
+INSERT INTO big_a VALUES (246, 'a246');
+INSERT INTO big_a VALUES (247, 'a247');
+INSERT INTO big_a VALUES (248, 'a248');
+INSERT INTO big_a VALUES (249, 'a249');
+INSERT INTO big_a VALUES (250, 'a250');
+INSERT INTO big_a VALUES (251, 'a251');
+INSERT INTO big_a VALUES (252, 'a252');
+INSERT INTO big_a VALUES (253, 'a253');
+INSERT INTO big_a VALUES (254, 'a254');
+INSERT INTO big_a VALUES (255, 'a255');
+INSERT INTO big_a VALUES (256, 'a256');
+INSERT INTO big_a VALUES (257, 'a257');
+INSERT INTO big_a VALUES (258, 'a258');
+INSERT INTO big_a VALUES (259, 'a259');
+INSERT INTO big_a VALUES (260, 'a260');
+INSERT INTO big_a VALUES (261, 'a261');
+INSERT INTO big_a VALUES (262, 'a262');
+INSERT INTO big_a VALUES (263, 'a263');
+INSERT INTO big_a VALUES (264, 'a264');
+INSERT INTO big_a VALUES (265, 'a265');
+INSERT INTO big_a VALUES (266, 'a266');
+INSERT INTO big_a VALUES (267, 'a267');
+INSERT INTO big_a VALUES (268, 'a268');
+INSERT INTO big_a VALUES (269, 'a269');
+INSERT INTO big_a VALUES (270, 'a270');
+INSERT INTO big_a VALUES (271, 'a271');
+INSERT INTO big_a VALUES (272, 'a272');
+INSERT INTO big_a VALUES (273, 'a273');
+INSERT INTO big_a VALUES (274, 'a274');
+INSERT INTO big_a VALUES (275, 'a275');
+INSERT INTO big_a VALUES (276, 'a276');
+INSERT INTO big_a VALUES (277, 'a277');
+INSERT INTO big_a VALUES (278, 'a278');
+INSERT INTO big_a VALUES (279, 'a279');
+INSERT INTO big_a VALUES (280, 'a280');
+INSERT INTO big_a VALUES (281, 'a281');
+INSERT INTO big_a VALUES (282, 'a282');
+INSERT INTO big_a VALUES (283, 'a283');
+INSERT INTO big_a VALUES (284, 'a284');
+INSERT INTO big_a VALUES (285, 'a285');
+INSERT INTO big_a VALUES (286, 'a286');
+INSERT INTO big_a VALUES (287, 'a287');
+INSERT INTO big_a VALUES (288, 'a288');
+INSERT INTO big_a VALUES (289, 'a289');
+INSERT INTO big_a VALUES (290, 'a290');
+INSERT INTO big_a VALUES (291, 'a291');
+INSERT INTO big_a VALUES (292, 'a292');
+INSERT INTO big_a VALUES (293, 'a293');
+INSERT INTO big_a VALUES (294, 'a294');
+INSERT INTO big_a VALUES (295, 'a295');
+INSERT INTO big_a VALUES (296, 'a296');
+INSERT INTO big_a VALUES (297, 'a297');
+INSERT INTO big_a VALUES (298, 'a298');
+INSERT INTO big_a VALUES (299, 'a299');
+INSERT INTO big_a VALUES (300, 'a300');
+INSERT INTO big_a VALUES (301, 'a301');
+INSERT INTO big_a VALUES (302, 'a302');
+INSERT INTO big_a VALUES (303, 'a303');
+INSERT INTO big_a VALUES (304, 'a304');
+INSERT INTO big_a VALUES (305, 'a305');
+INSERT INTO big_a VALUES (306, 'a306');
+INSERT INTO big_a VALUES (307, 'a307');
+INSERT INTO big_a VALUES (308, 'a308');
+INSERT INTO big_a VALUES (309, 'a309');
+INSERT INTO big_a VALUES (310, 'a310');
+INSERT INTO big_a VALUES (311, 'a311');
+INSERT INTO big_a VALUES (312, 'a312');
+INSERT INTO big_a VALUES (313, 'a313');
+INSERT INTO big_a VALUES (314, 'a314');
+INSERT INTO big_a VALUES (315, 'a315');
+INSERT INTO big_a VALUES (316, 'a316');
+INSERT INTO big_a VALUES (317, 'a317');
+INSERT INTO big_a VALUES (318, 'a318');
+INSERT INTO big_a VALUES (319, 'a319');
+INSERT INTO big_a VALUES (320, 'a320');
+INSERT INTO big_a VALUES (321, 'a321');
+INSERT INTO big_a VALUES (322, 'a322');
+INSERT INTO big_a VALUES (323, 'a323');
+INSERT INTO big_a VALUES (324, 'a324');
+INSERT INTO big_a VALUES (325, 'a325');
+INSERT INTO big_a VALUES (326, 'a326');
+INSERT INTO big_a VALUES (327, 'a327');
+INSERT INTO big_a VALUES (328, 'a328');
+INSERT INTO big_a VALUES (329, 'a329');
+INSERT INTO big_a VALUES (330, 'a330');
+INSERT INTO big_a VALUES (331, 'a331');
+INSERT INTO big_a VALUES (332, 'a332');
+INSERT INTO big_a VALUES (333, 'a333');
+INSERT INTO big_a VALUES (334, 'a334');
+INSERT INTO big_a VALUES (335, 'a335');
+INSERT INTO big_a VALUES (336, 'a336');
+INSERT INTO big_a VALUES (337, 'a337');
+INSERT INTO big_a VALUES (338, 'a338');
+INSERT INTO big_a VALUES (339, 'a339');
+INSERT INTO big_a VALUES (340, 'a340');
+INSERT INTO big_a VALUES (341, 'a341');
+INSERT INTO big_a VALUES (342, 'a342');
+INSERT INTO big_a VALUES (343, 'a343');
+INSERT INTO big_a VALUES (344, 'a344');
+INSERT INTO big_a VALUES (345, 'a345');
+INSERT INTO big_a VALUES (346, 'a346');
+INSERT INTO big_a VALUES (347, 'a347');
+INSERT INTO big_a VALUES (348, 'a348');
+INSERT INTO big_a VALUES (349, 'a349');
+INSERT INTO big_a VALUES (350, 'a350');
+INSERT INTO big_a VALUES (351, 'a351');
+INSERT INTO big_a VALUES (352, 'a352');
+INSERT INTO big_a VALUES (353, 'a353');
+INSERT INTO big_a VALUES (354, 'a354');
+INSERT INTO big_a VALUES (355, 'a355');
+INSERT INTO big_a VALUES (356, 'a356');
+INSERT INTO big_a VALUES (357, 'a357');
+INSERT INTO big_a VALUES (358, 'a358');
+INSERT INTO big_a VALUES (359, 'a359');
+INSERT INTO big_a VALUES (360, 'a360');
+INSERT INTO big_a VALUES (361, 'a361');
+INSERT INTO big_a VALUES (362, 'a362');
+INSERT INTO big_a VALUES (363, 'a363');
+INSERT INTO big_a VALUES (364, 'a364');
+INSERT INTO big_a VALUES (365, 'a365');
+INSERT INTO big_a VALUES (366, 'a366');
+INSERT INTO big_a VALUES (367, 'a367');
+INSERT INTO big_a VALUES (368, 'a368');
+INSERT INTO big_a VALUES (369, 'a369');
+INSERT INTO big_a VALUES (370, 'a370');
+INSERT INTO big_a VALUES (371, 'a371');
+INSERT INTO big_a VALUES (372, 'a372');
+INSERT INTO big_a VALUES (373, 'a373');
+INSERT INTO big_a VALUES (374, 'a374');
+INSERT INTO big_a VALUES (375, 'a375');
+INSERT INTO big_a VALUES (376, 'a376');
+INSERT INTO big_a VALUES (377, 'a377');
+INSERT INTO big_a VALUES (378, 'a378');
+INSERT INTO big_a VALUES (379, 'a379');
+INSERT INTO big_a VALUES (380, 'a380');
+INSERT INTO big_a VALUES (381, 'a381');
+INSERT INTO big_a VALUES (382, 'a382');
+INSERT INTO big_a VALUES (383, 'a383');
+INSERT INTO big_a VALUES (384, 'a384');
+INSERT INTO big_a VALUES (385, 'a385');
+INSERT INTO big_a VALUES (386, 'a386');
+INSERT INTO big_a VALUES (387, 'a387');
+INSERT INTO big_a VALUES (388, 'a388');
+INSERT INTO big_a VALUES (389, 'a389');
+INSERT INTO big_a VALUES (390, 'a390');
+INSERT INTO big_a VALUES (391, 'a391');
+INSERT INTO big_a VALUES (392, 'a392');
+INSERT INTO big_a VALUES (393, 'a393');
+INSERT INTO big_a VALUES (394, 'a394');
+INSERT INTO big_a VALUES (395, 'a395');
+INSERT INTO big_a VALUES (396, 'a396');
+INSERT INTO big_a VALUES (397, 'a397');
+INSERT INTO big_a VALUES (398, 'a398');
+INSERT INTO big_a VALUES (399, 'a399');
+INSERT INTO big_a VALUES (400, 'a400');
+INSERT INTO big_a VALUES (401, 'a401');
+INSERT INTO big_a VALUES (402, 'a402');
+INSERT INTO big_a VALUES (403, 'a403');
+INSERT INTO big_a VALUES (404, 'a404');
+INSERT INTO big_a VALUES (405, 'a405');
+INSERT INTO big_a VALUES (406, 'a406');
+INSERT INTO big_a VALUES (407, 'a407');
+INSERT INTO big_a VALUES (408, 'a408');
+INSERT INTO big_a VALUES (409, 'a409');
+INSERT INTO big_a VALUES (410, 'a410');
+INSERT INTO big_a VALUES (411, 'a411');
+INSERT INTO big_a VALUES (412, 'a412');
+INSERT INTO big_a VALUES (413, 'a413');
+INSERT INTO big_a VALUES (414, 'a414');
+INSERT INTO big_a VALUES (415, 'a415');
+INSERT INTO big_a VALUES (416, 'a416');
+INSERT INTO big_a VALUES (417, 'a417');
+INSERT INTO big_a VALUES (418, 'a418');
+INSERT INTO big_a VALUES (419, 'a419');
+INSERT INTO big_a VALUES (420, 'a420');
+INSERT INTO big_a VALUES (421, 'a421');
+INSERT INTO big_a VALUES (422, 'a422');
+INSERT INTO big_a VALUES (423, 'a423');
+INSERT INTO big_a VALUES (424, 'a424');
+INSERT INTO big_a VALUES (425, 'a425');
+INSERT INTO big_a VALUES (426, 'a426');
+INSERT INTO big_a VALUES (427, 'a427');
+INSERT INTO big_a VALUES (428, 'a428');
+INSERT INTO big_a VALUES (429, 'a429');
+INSERT INTO big_a VALUES (430, 'a430');
+INSERT INTO big_a VALUES (431, 'a431');
+INSERT INTO big_a VALUES (432, 'a432');
+INSERT INTO big_a VALUES (433, 'a433');
+INSERT INTO big_a VALUES (434, 'a434');
+INSERT INTO big_a VALUES (435, 'a435');
+INSERT INTO big_a VALUES (436, 'a436');
+INSERT INTO big_a VALUES (437, 'a437');
+INSERT INTO big_a VALUES (438, 'a438');
+INSERT INTO big_a VALUES (439, 'a439');
+INSERT INTO big_a VALUES (440, 'a440');
+INSERT INTO big_a VALUES (441, 'a441');
+INSERT INTO big_a VALUES (442, 'a442');
+INSERT INTO big_a VALUES (443, 'a443');
+INSERT INTO big_a VALUES (444, 'a444');
+INSERT INTO big_a VALUES (445, 'a445');
+INSERT INTO big_a VALUES (446, 'a446');
+INSERT INTO big_a VALUES (447, 'a447');
+INSERT INTO big_a VALUES (448, 'a448');
+INSERT INTO big_a VALUES (449, 'a449');
+INSERT INTO big_a VALUES (450, 'a450');
+INSERT INTO big_a VALUES (451, 'a451');
+INSERT INTO big_a VALUES (452, 'a452');
+INSERT INTO big_a VALUES (453, 'a453');
+INSERT INTO big_a VALUES (454, 'a454');
+INSERT INTO big_a VALUES (455, 'a455');
+INSERT INTO big_a VALUES (456, 'a456');
+INSERT INTO big_a VALUES (457, 'a457');
+INSERT INTO big_a VALUES (458, 'a458');
+INSERT INTO big_a VALUES (459, 'a459');
+INSERT INTO big_a VALUES (460, 'a460');
+INSERT INTO big_a VALUES (461, 'a461');
+INSERT INTO big_a VALUES (462, 'a462');
+INSERT INTO big_a VALUES (463, 'a463');
+INSERT INTO big_a VALUES (464, 'a464');
+INSERT INTO big_a VALUES (465, 'a465');
+INSERT INTO big_a VALUES (466, 'a466');
+INSERT INTO big_a VALUES (467, 'a467');
+INSERT INTO big_a VALUES (468, 'a468');
+INSERT INTO big_a VALUES (469, 'a469');
+INSERT INTO big_a VALUES (470, 'a470');
+INSERT INTO big_a VALUES (471, 'a471');
+INSERT INTO big_a VALUES (472, 'a472');
+INSERT INTO big_a VALUES (473, 'a473');
+INSERT INTO big_a VALUES (474, 'a474');
+INSERT INTO big_a VALUES (475, 'a475');
+INSERT INTO big_a VALUES (476, 'a476');
+INSERT INTO big_a VALUES (477, 'a477');
+INSERT INTO big_a VALUES (478, 'a478');
+INSERT INTO big_a VALUES (479, 'a479');
+INSERT INTO big_a VALUES (480, 'a480');
+INSERT INTO big_a VALUES (481, 'a481');
+INSERT INTO big_a VALUES (482, 'a482');
+INSERT INTO big_a VALUES (483, 'a483');
+INSERT INTO big_a VALUES (484, 'a484');
+INSERT INTO big_a VALUES (485, 'a485');
+INSERT INTO big_a VALUES (486, 'a486');
+INSERT INTO big_a VALUES (487, 'a487');
+INSERT INTO big_a VALUES (488, 'a488');
+INSERT INTO big_a VALUES (489, 'a489');
+INSERT INTO big_a VALUES (490, 'a490');
+INSERT INTO big_a VALUES (491, 'a491');
+INSERT INTO big_a VALUES (492, 'a492');
+INSERT INTO big_a VALUES (493, 'a493');
+INSERT INTO big_a VALUES (494, 'a494');
+INSERT INTO big_a VALUES (495, 'a495');
+INSERT INTO big_a VALUES (496, 'a496');
+INSERT INTO big_a VALUES (497, 'a497');
+INSERT INTO big_a VALUES (498, 'a498');
+INSERT INTO big_a VALUES (499, 'a499');
+INSERT INTO big_a VALUES (500, 'a500');
+INSERT INTO big_a VALUES (501, 'a501');
+INSERT INTO big_a VALUES (502, 'a502');
+INSERT INTO big_a VALUES (503, 'a503');
+INSERT INTO big_a VALUES (504, 'a504');
+INSERT INTO big_a VALUES (505, 'a505');
+INSERT INTO big_a VALUES (506, 'a506');
+INSERT INTO big_a VALUES (507, 'a507');
+INSERT INTO big_a VALUES (508, 'a508');
+INSERT INTO big_a VALUES (509, 'a509');
+INSERT INTO big_a VALUES (510, 'a510');
+INSERT INTO big_a VALUES (511, 'a511');
+INSERT INTO big_a VALUES (512, 'a512');
+INSERT INTO big_a VALUES (513, 'a513');
+INSERT INTO big_a VALUES (514, 'a514');
+INSERT INTO big_a VALUES (515, 'a515');
+INSERT INTO big_a VALUES (516, 'a516');
+INSERT INTO big_a VALUES (517, 'a517');
+INSERT INTO big_a VALUES (518, 'a518');
+INSERT INTO big_a VALUES (519, 'a519');
+INSERT INTO big_a VALUES (520, 'a520');
+INSERT INTO big_a VALUES (521, 'a521');
+INSERT INTO big_a VALUES (522, 'a522');
+INSERT INTO big_a VALUES (523, 'a523');
+INSERT INTO big_a VALUES (524, 'a524');
+INSERT INTO big_a VALUES (525, 'a525');
+INSERT INTO big_a VALUES (526, 'a526');
+INSERT INTO big_a VALUES (527, 'a527');
+INSERT INTO big_a VALUES (528, 'a528');
+INSERT INTO big_a VALUES (529, 'a529');
+INSERT INTO big_a VALUES (530, 'a530');
+INSERT INTO big_a VALUES (531, 'a531');
+INSERT INTO big_a VALUES (532, 'a532');
+INSERT INTO big_a VALUES (533, 'a533');
+INSERT INTO big_a VALUES (534, 'a534');
+INSERT INTO big_a VALUES (535, 'a535');
+INSERT INTO big_a VALUES (536, 'a536');
+INSERT INTO big_a VALUES (537, 'a537');
+INSERT INTO big_a VALUES (538, 'a538');
+INSERT INTO big_a VALUES (539, 'a539');
+INSERT INTO big_a VALUES (540, 'a540');
+INSERT INTO big_a VALUES (541, 'a541');
+INSERT INTO big_a VALUES (542, 'a542');
+INSERT INTO big_a VALUES (543, 'a543');
+INSERT INTO big_a VALUES (544, 'a544');
+INSERT INTO big_a VALUES (545, 'a545');
+INSERT INTO big_a VALUES (546, 'a546');
+INSERT INTO big_a VALUES (547, 'a547');
+INSERT INTO big_a VALUES (548, 'a548');
+INSERT INTO big_a VALUES (549, 'a549');
+INSERT INTO big_a VALUES (550, 'a550');
+INSERT INTO big_a VALUES (551, 'a551');
+INSERT INTO big_a VALUES (552, 'a552');
+INSERT INTO big_a VALUES (553, 'a553');
+INSERT INTO big_a VALUES (554, 'a554');
+INSERT INTO big_a VALUES (555, 'a555');
+INSERT INTO big_a VALUES (556, 'a556');
+INSERT INTO big_a VALUES (557, 'a557');
+INSERT INTO big_a VALUES (558, 'a558');
+INSERT INTO big_a VALUES (559, 'a559');
+INSERT INTO big_a VALUES (560, 'a560');
+INSERT INTO big_a VALUES (561, 'a561');
+INSERT INTO big_a VALUES (562, 'a562');
+INSERT INTO big_a VALUES (563, 'a563');
+INSERT INTO big_a VALUES (564, 'a564');
+INSERT INTO big_a VALUES (565, 'a565');
+INSERT INTO big_a VALUES (566, 'a566');
+INSERT INTO big_a VALUES (567, 'a567');
+INSERT INTO big_a VALUES (568, 'a568');
+INSERT INTO big_a VALUES (569, 'a569');
+INSERT INTO big_a VALUES (570, 'a570');
+INSERT INTO big_a VALUES (571, 'a571');
+INSERT INTO big_a VALUES (572, 'a572');
+INSERT INTO big_a VALUES (573, 'a573');
+INSERT INTO big_a VALUES (574, 'a574');
+INSERT INTO big_a VALUES (575, 'a575');
+INSERT INTO big_a VALUES (576, 'a576');
+INSERT INTO big_a VALUES (577, 'a577');
+INSERT INTO big_a VALUES (578, 'a578');
+INSERT INTO big_a VALUES (579, 'a579');
+INSERT INTO big_a VALUES (580, 'a580');
+INSERT INTO big_a VALUES (581, 'a581');
+INSERT INTO big_a VALUES (582, 'a582');
+INSERT INTO big_a VALUES (583, 'a583');
+INSERT INTO big_a VALUES (584, 'a584');
+INSERT INTO big_a VALUES (585, 'a585');
+INSERT INTO big_a VALUES (586, 'a586');
+INSERT INTO big_a VALUES (587, 'a587');
+INSERT INTO big_a VALUES (588, 'a588');
+INSERT INTO big_a VALUES (589, 'a589');
+INSERT INTO big_a VALUES (590, 'a590');
+INSERT INTO big_a VALUES (591, 'a591');
+INSERT INTO big_a VALUES (592, 'a592');
+INSERT INTO big_a VALUES (593, 'a593');
+INSERT INTO big_a VALUES (594, 'a594');
+INSERT INTO big_a VALUES (595, 'a595');
+INSERT INTO big_a VALUES (596, 'a596');
+INSERT INTO big_a VALUES (597, 'a597');
+INSERT INTO big_a VALUES (598, 'a598');
+INSERT INTO big_a VALUES (599, 'a599');
+INSERT INTO big_a VALUES (600, 'a600');
+INSERT INTO big_b VALUES (0.50, 'b1');
+INSERT INTO big_b VALUES (1.00, 'b2');
+INSERT INTO big_b VALUES (1.50, 'b3');
+INSERT INTO big_b VALUES (2.00, 'b4');
+INSERT INTO big_b VALUES (2.50, 'b5');
+INSERT INTO big_b VALUES (3.00, 'b6');
+INSERT INTO big_b VALUES (3.50, 'b7');
+INSERT INTO big_b VALUES (4.00, 'b8');
+INSERT INTO big_b VALUES (4.50, 'b9');
+INSERT INTO big_b VALUES (5.00, 'b10');
+INSERT INTO big_b VALUES (5.50, 'b11');
+INSERT INTO big_b VALUES (6.00, 'b12');
+INSERT INTO big_b VALUES (6.50, 'b13');
+INSERT INTO big_b VALUES (7.00, 'b14');
+INSERT INTO big_b VALUES (7.50, 'b15');
+INSERT INTO big_b VALUES (8.00, 'b16');
+INSERT INTO big_b VALUES (8.50, 'b17');
+INSERT INTO big_b VALUES (9.00, 'b18');
+INSERT INTO big_b VALUES (9.50, 'b19');
+INSERT INTO big_b VALUES (10.00, 'b20');
+INSERT INTO big_b VALUES (10.50, 'b21');
+INSERT INTO big_b VALUES (11.00, 'b22');
+INSERT INTO big_b VALUES (11.50, 'b23');
+INSERT INTO big_b VALUES (12.00, 'b24');
+INSERT INTO big_b VALUES (12.50, 'b25');
+INSERT INTO big_b VALUES (13.00, 'b26');
+INSERT INTO big_b VALUES (13.50, 'b27');
+INSERT INTO big_b VALUES (14.00, 'b28');
+INSERT INTO big_b VALUES (14.50, 'b29');
+INSERT INTO big_b VALUES (15.00, 'b30');
+INSERT INTO big_b VALUES (15.50, 'b31');
+INSERT INTO big_b VALUES (16.00, 'b32');
+INSERT INTO big_b VALUES (16.50, 'b33');
+INSERT INTO big_b VALUES (17.00, 'b34');
+INSERT INTO big_b VALUES (17.50, 'b35');
+INSERT INTO big_b VALUES (18.00, 'b36');
+INSERT INTO big_b VALUES (18.50, 'b37');
+INSERT INTO big_b VALUES (19.00, 'b38');
+INSERT INTO big_b VALUES (19.50, 'b39');
+INSERT INTO big_b VALUES (20.00, 'b40');
+INSERT INTO big_b VALUES (20.50, 'b41');
+INSERT INTO big_b VALUES (21.00, 'b42');
+INSERT INTO big_b VALUES (21.50, 'b43');
+INSERT INTO big_b VALUES (22.00, 'b44');
+INSERT INTO big_b VALUES (22.50, 'b45');
+INSERT INTO big_b VALUES (23.00, 'b46');
+INSERT INTO big_b VALUES (23.50, 'b47');
+INSERT INTO big_b VALUES (24.00, 'b48');
+INSERT INTO big_b VALUES (24.50, 'b49');
+INSERT INTO big_b VALUES (25.00, 'b50');
+INSERT INTO big_b VALUES (25.50, 'b51');
+INSERT INTO big_b VALUES (26.00, 'b52');
+INSERT INTO big_b VALUES (26.50, 'b53');
+INSERT INTO big_b VALUES (27.00, 'b54');
+INSERT INTO big_b VALUES (27.50, 'b55');
+INSERT INTO big_b VALUES (28.00, 'b56');
+INSERT INTO big_b VALUES (28.50, 'b57');
+INSERT INTO big_b VALUES (29.00, 'b58');
+INSERT INTO big_b VALUES (29.50, 'b59');
+INSERT INTO big_b VALUES (30.00, 'b60');
+INSERT INTO big_b VALUES (30.50, 'b61');
+INSERT INTO big_b VALUES (31.00, 'b62');
+INSERT INTO big_b VALUES (31.50, 'b63');
+INSERT INTO big_b VALUES (32.00, 'b64');
+INSERT INTO big_b VALUES (32.50, 'b65');
+INSERT INTO big_b VALUES (33.00, 'b66');
+INSERT INTO big_b VALUES (33.50, 'b67');
+INSERT INTO big_b VALUES (34.00, 'b68');
+INSERT INTO big_b VALUES (34.50, 'b69');
+INSERT INTO big_b VALUES (35.00, 'b70');
+INSERT INTO big_b VALUES (35.50, 'b71');
+INSERT INTO big_b VALUES (36.00, 'b72');
+INSERT INTO big_b VALUES (36.50, 'b73');
+INSERT INTO big_b VALUES (37.00, 'b74');
+INSERT INTO big_b VALUES (37.50, 'b75');
+INSERT INTO big_b VALUES (38.00, 'b76');
+INSERT INTO big_b VALUES (38.50, 'b77');
+INSERT INTO big_b VALUES (39.00, 'b78');
+INSERT INTO big_b VALUES (39.50, 'b79');
+INSERT INTO big_b VALUES (40.00, 'b80');
+INSERT INTO big_b VALUES (40.50, 'b81');
+INSERT INTO big_b VALUES (41.00, 'b82');
+INSERT INTO big_b VALUES (41.50, 'b83');
+INSERT INTO big_b VALUES (42.00, 'b84');
+INSERT INTO big_b VALUES (42.50, 'b85');
+INSERT INTO big_b VALUES (43.00, 'b86');
+INSERT INTO big_b VALUES (43.50, 'b87');
+INSERT INTO big_b VALUES (44.00, 'b88');
+INSERT INTO big_b VALUES (44.50, 'b89');
+INSERT INTO big_b VALUES (45.00, 'b90');
+INSERT INTO big_b VALUES (45.50, 'b91');
+INSERT INTO big_b VALUES (46.00, 'b92');
+INSERT INTO big_b VALUES (46.50, 'b93');
+INSERT INTO big_b VALUES (47.00, 'b94');
+INSERT INTO big_b VALUES (47.50, 'b95');
+INSERT INTO big_b VALUES (48.00, 'b96');
+INSERT INTO big_b VALUES (48.50, 'b97');
+INSERT INTO big_b VALUES (49.00, 'b98');
+INSERT INTO big_b VALUES (49.50, 'b99');
+INSERT INTO big_b VALUES (50.00, 'b100');
+INSERT INTO big_b VALUES (50.50, 'b101');
+INSERT INTO big_b VALUES (51.00, 'b102');
+INSERT INTO big_b VALUES (51.50, 'b103');
+INSERT INTO big_b VALUES (52.00, 'b104');
+INSERT INTO big_b VALUES (52.50, 'b105');
+INSERT INTO big_b VALUES (53.00, 'b106');
+INSERT INTO big_b VALUES (53.50, 'b107');
+INSERT INTO big_b VALUES (54.00, 'b108');
+INSERT INTO big_b VALUES (54.50, 'b109');
+INSERT INTO big_b VALUES (55.00, 'b110');
+INSERT INTO big_b VALUES (55.50, 'b111');
+INSERT INTO big_b VALUES (56.00, 'b112');
+INSERT INTO big_b VALUES (56.50, 'b113');
+INSERT INTO big_b VALUES (57.00, 'b114');
+INSERT INTO big_b VALUES (57.50, 'b115');
+INSERT INTO big_b VALUES (58.00, 'b116');
+INSERT INTO big_b VALUES (58.50, 'b117');
+INSERT INTO big_b VALUES (59.00, 'b118');
+INSERT INTO big_b VALUES (59.50, 'b119');
+INSERT INTO big_b VALUES (60.00, 'b120');
+INSERT INTO big_b VALUES (60.50, 'b121');
+INSERT INTO big_b VALUES (61.00, 'b122');
+INSERT INTO big_b VALUES (61.50, 'b123');
+INSERT INTO big_b VALUES (62.00, 'b124');
+INSERT INTO big_b VALUES (62.50, 'b125');
+INSERT INTO big_b VALUES (63.00, 'b126');
+INSERT INTO big_b VALUES (63.50, 'b127');
+INSERT INTO big_b VALUES (64.00, 'b128');
+INSERT INTO big_b VALUES (64.50, 'b129');
+INSERT INTO big_b VALUES (65.00, 'b130');
+INSERT INTO big_b VALUES (65.50, 'b131');
+INSERT INTO big_b VALUES (66.00, 'b132');
+INSERT INTO big_b VALUES (66.50, 'b133');
+INSERT INTO big_b VALUES (67.00, 'b134');
+INSERT INTO big_b VALUES (67.50, 'b135');
+INSERT INTO big_b VALUES (68.00, 'b136');
+INSERT INTO big_b VALUES (68.50, 'b137');
+INSERT INTO big_b VALUES (69.00, 'b138');
+INSERT INTO big_b VALUES (69.50, 'b139');
+INSERT INTO big_b VALUES (70.00, 'b140');
+INSERT INTO big_b VALUES (70.50, 'b141');
+INSERT INTO big_b VALUES (71.00, 'b142');
+INSERT INTO big_b VALUES (71.50, 'b143');
+INSERT INTO big_b VALUES (72.00, 'b144');
+INSERT INTO big_b VALUES (72.50, 'b145');
+INSERT INTO big_b VALUES (73.00, 'b146');
+INSERT INTO big_b VALUES (73.50, 'b147');
+INSERT INTO big_b VALUES (74.00, 'b148');
+INSERT INTO big_b VALUES (74.50, 'b149');
+INSERT INTO big_b VALUES (75.00, 'b150');
+INSERT INTO big_b VALUES (75.50, 'b151');
+INSERT INTO big_b VALUES (76.00, 'b152');
+INSERT INTO big_b VALUES (76.50, 'b153');
+INSERT INTO big_b VALUES (77.00, 'b154');
+INSERT INTO big_b VALUES (77.50, 'b155');
+INSERT INTO big_b VALUES (78.00, 'b156');
+INSERT INTO big_b VALUES (78.50, 'b157');
+INSERT INTO big_b VALUES (79.00, 'b158');
+INSERT INTO big_b VALUES (79.50, 'b159');
+INSERT INTO big_b VALUES (80.00, 'b160');
+INSERT INTO big_b VALUES (80.50, 'b161');
+INSERT INTO big_b VALUES (81.00, 'b162');
+INSERT INTO big_b VALUES (81.50, 'b163');
+INSERT INTO big_b VALUES (82.00, 'b164');
+INSERT INTO big_b VALUES (82.50, 'b165');
+INSERT INTO big_b VALUES (83.00, 'b166');
+INSERT INTO big_b VALUES (83.50, 'b167');
+INSERT INTO big_b VALUES (84.00, 'b168');
+INSERT INTO big_b VALUES (84.50, 'b169');
+INSERT INTO big_b VALUES (85.00, 'b170');
+INSERT INTO big_b VALUES (85.50, 'b171');
+INSERT INTO big_b VALUES (86.00, 'b172');
+INSERT INTO big_b VALUES (86.50, 'b173');
+INSERT INTO big_b VALUES (87.00, 'b174');
+INSERT INTO big_b VALUES (87.50, 'b175');
+INSERT INTO big_b VALUES (88.00, 'b176');
+INSERT INTO big_b VALUES (88.50, 'b177');
+INSERT INTO big_b VALUES (89.00, 'b178');
+INSERT INTO big_b VALUES (89.50, 'b179');
+INSERT INTO big_b VALUES (90.00, 'b180');
+INSERT INTO big_b VALUES (90.50, 'b181');
+INSERT INTO big_b VALUES (91.00, 'b182');
+INSERT INTO big_b VALUES (91.50, 'b183');
+INSERT INTO big_b VALUES (92.00, 'b184');
+INSERT INTO big_b VALUES (92.50, 'b185');
+INSERT INTO big_b VALUES (93.00, 'b186');
+INSERT INTO big_b VALUES (93.50, 'b187');
+INSERT INTO big_b VALUES (94.00, 'b188');
+INSERT INTO big_b VALUES (94.50, 'b189');
+INSERT INTO big_b VALUES (95.00, 'b190');
+INSERT INTO big_b VALUES (95.50, 'b191');
+INSERT INTO big_b VALUES (96.00, 'b192');
+INSERT INTO big_b VALUES (96.50, 'b193');
+INSERT INTO big_b VALUES (97.00, 'b194');
+INSERT INTO big_b VALUES (97.50, 'b195');
+INSERT INTO big_b VALUES (98.00, 'b196');
+INSERT INTO big_b VALUES (98.50, 'b197');
+INSERT INTO big_b VALUES (99.00, 'b198');
+INSERT INTO big_b VALUES (99.50, 'b199');
+INSERT INTO big_b VALUES (100.00, 'b200');
+INSERT INTO big_b VALUES (100.50, 'b201');
+INSERT INTO big_b VALUES (101.00, 'b202');
+INSERT INTO big_b VALUES (101.50, 'b203');
+INSERT INTO big_b VALUES (102.00, 'b204');
+INSERT INTO big_b VALUES (102.50, 'b205');
+INSERT INTO big_b VALUES (103.00, 'b206');
+INSERT INTO big_b VALUES (103.50, 'b207');
+INSERT INTO big_b VALUES (104.00, 'b208');
+INSERT INTO big_b VALUES (104.50, 'b209');
+INSERT INTO big_b VALUES (105.00, 'b210');
+INSERT INTO big_b VALUES (105.50, 'b211');
+INSERT INTO big_b VALUES (106.00, 'b212');
+INSERT INTO big_b VALUES (106.50, 'b213');
+INSERT INTO big_b VALUES (107.00, 'b214');
+INSERT INTO big_b VALUES (107.50, 'b215');
+INSERT INTO big_b VALUES (108.00, 'b216');
+INSERT INTO big_b VALUES (108.50, 'b217');
+INSERT INTO big_b VALUES (109.00, 'b218');
+INSERT INTO big_b VALUES (109.50, 'b219');
+INSERT INTO big_b VALUES (110.00, 'b220');
+INSERT INTO big_b VALUES (110.50, 'b221');
+INSERT INTO big_b VALUES (111.00, 'b222');
+INSERT INTO big_b VALUES (111.50, 'b223');
+INSERT INTO big_b VALUES (112.00, 'b224');
+INSERT INTO big_b VALUES (112.50, 'b225');
+INSERT INTO big_b VALUES (113.00, 'b226');
+INSERT INTO big_b VALUES (113.50, 'b227');
+INSERT INTO big_b VALUES (114.00, 'b228');
+INSERT INTO big_b VALUES (114.50, 'b229');
+INSERT INTO big_b VALUES (115.00, 'b230');
+INSERT INTO big_b VALUES (115.50, 'b231');
+INSERT INTO big_b VALUES (116.00, 'b232');
+INSERT INTO big_b VALUES (116.50, 'b233');
+INSERT INTO big_b VALUES (117.00, 'b234');
+INSERT INTO big_b VALUES (117.50, 'b235');
+INSERT INTO big_b VALUES (118.00, 'b236');
+INSERT INTO big_b VALUES (118.50, 'b237');
+INSERT INTO big_b VALUES (119.00, 'b238');
+INSERT INTO big_b VALUES (119.50, 'b239');
+INSERT INTO big_b VALUES (120.00, 'b240');
+INSERT INTO big_b VALUES (120.50, 'b241');
+INSERT INTO big_b VALUES (121.00, 'b242');
+INSERT INTO big_b VALUES (121.50, 'b243');
+INSERT INTO big_b VALUES (122.00, 'b244');
+INSERT INTO big_b VALUES (122.50, 'b245');
+INSERT INTO big_b VALUES (123.00, 'b246');
+INSERT INTO big_b VALUES (123.50, 'b247');
+INSERT INTO big_b VALUES (124.00, 'b248');
+INSERT INTO big_b VALUES (124.50, 'b249');
+INSERT INTO big_b VALUES (125.00, 'b250');
+INSERT INTO big_b VALUES (125.50, 'b251');
+INSERT INTO big_b VALUES (126.00, 'b252');
+INSERT INTO big_b VALUES (126.50, 'b253');
+INSERT INTO big_b VALUES (127.00, 'b254');
+INSERT INTO big_b VALUES (127.50, 'b255');
+INSERT INTO big_b VALUES (128.00, 'b256');
+INSERT INTO big_b VALUES (128.50, 'b257');
+INSERT INTO big_b VALUES (129.00, 'b258');
+INSERT INTO big_b VALUES (129.50, 'b259');
+INSERT INTO big_b VALUES (130.00, 'b260');
+INSERT INTO big_b VALUES (130.50, 'b261');
+INSERT INTO big_b VALUES (131.00, 'b262');
+INSERT INTO big_b VALUES (131.50, 'b263');
+INSERT INTO big_b VALUES (132.00, 'b264');
+INSERT INTO big_b VALUES (132.50, 'b265');
+INSERT INTO big_b VALUES (133.00, 'b266');
+INSERT INTO big_b VALUES (133.50, 'b267');
+INSERT INTO big_b VALUES (134.00, 'b268');
+INSERT INTO big_b VALUES (134.50, 'b269');
+INSERT INTO big_b VALUES (135.00, 'b270');
+INSERT INTO big_b VALUES (135.50, 'b271');
+INSERT INTO big_b VALUES (136.00, 'b272');
+INSERT INTO big_b VALUES (136.50, 'b273');
+INSERT INTO big_b VALUES (137.00, 'b274');
+INSERT INTO big_b VALUES (137.50, 'b275');
+INSERT INTO big_b VALUES (138.00, 'b276');
+INSERT INTO big_b VALUES (138.50, 'b277');
+INSERT INTO big_b VALUES (139.00, 'b278');
+INSERT INTO big_b VALUES (139.50, 'b279');
+INSERT INTO big_b VALUES (140.00, 'b280');
+INSERT INTO big_b VALUES (140.50, 'b281');
+INSERT INTO big_b VALUES (141.00, 'b282');
+INSERT INTO big_b VALUES (141.50, 'b283');
+INSERT INTO big_b VALUES (142.00, 'b284');
+INSERT INTO big_b VALUES (142.50, 'b285');
+INSERT INTO big_b VALUES (143.00, 'b286');
+INSERT INTO big_b VALUES (143.50, 'b287');
+INSERT INTO big_b VALUES (144.00, 'b288');
+INSERT INTO big_b VALUES (144.50, 'b289');
+INSERT INTO big_b VALUES (145.00, 'b290');
+INSERT INTO big_b VALUES (145.50, 'b291');
+INSERT INTO big_b VALUES (146.00, 'b292');
+INSERT INTO big_b VALUES (146.50, 'b293');
+INSERT INTO big_b VALUES (147.00, 'b294');
+INSERT INTO big_b VALUES (147.50, 'b295');
+INSERT INTO big_b VALUES (148.00, 'b296');
+INSERT INTO big_b VALUES (148.50, 'b297');
+INSERT INTO big_b VALUES (149.00, 'b298');
+INSERT INTO big_b VALUES (149.50, 'b299');
+INSERT INTO big_b VALUES (150.00, 'b300');
+INSERT INTO big_b VALUES (150.50, 'b301');
+INSERT INTO big_b VALUES (151.00, 'b302');
+INSERT INTO big_b VALUES (151.50, 'b303');
+INSERT INTO big_b VALUES (152.00, 'b304');
+INSERT INTO big_b VALUES (152.50, 'b305');
+INSERT INTO big_b VALUES (153.00, 'b306');
+INSERT INTO big_b VALUES (153.50, 'b307');
+INSERT INTO big_b VALUES (154.00, 'b308');
+INSERT INTO big_b VALUES (154.50, 'b309');
+INSERT INTO big_b VALUES (155.00, 'b310');
+INSERT INTO big_b VALUES (155.50, 'b311');
+INSERT INTO big_b VALUES (156.00, 'b312');
+INSERT INTO big_b VALUES (156.50, 'b313');
+INSERT INTO big_b VALUES (157.00, 'b314');
+INSERT INTO big_b VALUES (157.50, 'b315');
+INSERT INTO big_b VALUES (158.00, 'b316');
+INSERT INTO big_b VALUES (158.50, 'b317');
+INSERT INTO big_b VALUES (159.00, 'b318');
+INSERT INTO big_b VALUES (159.50, 'b319');
+INSERT INTO big_b VALUES (160.00, 'b320');
+INSERT INTO big_b VALUES (160.50, 'b321');
+INSERT INTO big_b VALUES (161.00, 'b322');
+INSERT INTO big_b VALUES (161.50, 'b323');
+INSERT INTO big_b VALUES (162.00, 'b324');
+INSERT INTO big_b VALUES (162.50, 'b325');
+INSERT INTO big_b VALUES (163.00, 'b326');
+INSERT INTO big_b VALUES (163.50, 'b327');
+INSERT INTO big_b VALUES (164.00, 'b328');
+INSERT INTO big_b VALUES (164.50, 'b329');
+INSERT INTO big_b VALUES (165.00, 'b330');
+INSERT INTO big_b VALUES (165.50, 'b331');
+INSERT INTO big_b VALUES (166.00, 'b332');
+INSERT INTO big_b VALUES (166.50, 'b333');
+INSERT INTO big_b VALUES (167.00, 'b334');
+INSERT INTO big_b VALUES (167.50, 'b335');
+INSERT INTO big_b VALUES (168.00, 'b336');
+INSERT INTO big_b VALUES (168.50, 'b337');
+INSERT INTO big_b VALUES (169.00, 'b338');
+INSERT INTO big_b VALUES (169.50, 'b339');
+INSERT INTO big_b VALUES (170.00, 'b340');
+INSERT INTO big_b VALUES (170.50, 'b341');
+INSERT INTO big_b VALUES (171.00, 'b342');
+INSERT INTO big_b VALUES (171.50, 'b343');
+INSERT INTO big_b VALUES (172.00, 'b344');
+INSERT INTO big_b VALUES (172.50, 'b345');
+INSERT INTO big_b VALUES (173.00, 'b346');
+INSERT INTO big_b VALUES (173.50, 'b347');
+INSERT INTO big_b VALUES (174.00, 'b348');
+INSERT INTO big_b VALUES (174.50, 'b349');
+INSERT INTO big_b VALUES (175.00, 'b350');
+INSERT INTO big_b VALUES (175.50, 'b351');
+INSERT INTO big_b VALUES (176.00, 'b352');
+INSERT INTO big_b VALUES (176.50, 'b353');
+INSERT INTO big_b VALUES (177.00, 'b354');
+INSERT INTO big_b VALUES (177.50, 'b355');
+INSERT INTO big_b VALUES (178.00, 'b356');
+INSERT INTO big_b VALUES (178.50, 'b357');
+INSERT INTO big_b VALUES (179.00, 'b358');
+INSERT INTO big_b VALUES (179.50, 'b359');
+INSERT INTO big_b VALUES (180.00, 'b360');
+INSERT INTO big_b VALUES (180.50, 'b361');
+INSERT INTO big_b VALUES (181.00, 'b362');
+INSERT INTO big_b VALUES (181.50, 'b363');
+INSERT INTO big_b VALUES (182.00, 'b364');
+INSERT INTO big_b VALUES (182.50, 'b365');
+INSERT INTO big_b VALUES (183.00, 'b366');
+INSERT INTO big_b VALUES (183.50, 'b367');
+INSERT INTO big_b VALUES (184.00, 'b368');
+INSERT INTO big_b VALUES (184.50, 'b369');
+INSERT INTO big_b VALUES (185.00, 'b370');
+INSERT INTO big_b VALUES (185.50, 'b371');
+INSERT INTO big_b VALUES (186.00, 'b372');
+INSERT INTO big_b VALUES (186.50, 'b373');
+INSERT INTO big_b VALUES (187.00, 'b374');
+INSERT INTO big_b VALUES (187.50, 'b375');
+INSERT INTO big_b VALUES (188.00, 'b376');
+INSERT INTO big_b VALUES (188.50, 'b377');
+INSERT INTO big_b VALUES (189.00, 'b378');
+INSERT INTO big_b VALUES (189.50, 'b379');
+INSERT INTO big_b VALUES (190.00, 'b380');
+INSERT INTO big_b VALUES (190.50, 'b381');
+INSERT INTO big_b VALUES (191.00, 'b382');
+INSERT INTO big_b VALUES (191.50, 'b383');
+INSERT INTO big_b VALUES (192.00, 'b384');
+INSERT INTO big_b VALUES (192.50, 'b385');
+INSERT INTO big_b VALUES (193.00, 'b386');
+INSERT INTO big_b VALUES (193.50, 'b387');
+INSERT INTO big_b VALUES (194.00, 'b388');
+INSERT INTO big_b VALUES (194.50, 'b389');
+INSERT INTO big_b VALUES (195.00, 'b390');
+INSERT INTO big_b VALUES (195.50, 'b391');
+INSERT INTO big_b VALUES (196.00, 'b392');
+INSERT INTO big_b VALUES (196.50, 'b393');
+INSERT INTO big_b VALUES (197.00, 'b394');
+INSERT INTO big_b VALUES (197.50, 'b395');
+INSERT INTO big_b VALUES (198.00, 'b396');
+INSERT INTO big_b VALUES (198.50, 'b397');
+INSERT INTO big_b VALUES (199.00, 'b398');
+INSERT INTO big_b VALUES (199.50, 'b399');
+INSERT INTO big_b VALUES (200.00, 'b400');
+CREATE TABLE big_c (
+v DECIMAL(8,1),
+note TEXT
+);
+INSERT INTO big_c VALUES (0.5, 'c1');
+INSERT INTO big_c VALUES (1.0, 'c2');
+INSERT INTO big_c VALUES (1.5, 'c3');
+INSERT INTO big_c VALUES (2.0, 'c4');
+INSERT INTO big_c VALUES (2.5, 'c5');
+INSERT INTO big_c VALUES (3.0, 'c6');
+INSERT INTO big_c VALUES (3.5, 'c7');
+INSERT INTO big_c VALUES (4.0, 'c8');
+INSERT INTO big_c VALUES (4.5, 'c9');
+INSERT INTO big_c VALUES (5.0, 'c10');
+INSERT INTO big_c VALUES (5.5, 'c11');
+INSERT INTO big_c VALUES (6.0, 'c12');
+INSERT INTO big_c VALUES (6.5, 'c13');
+INSERT INTO big_c VALUES (7.0, 'c14');
+INSERT INTO big_c VALUES (7.5, 'c15');
+INSERT INTO big_c VALUES (8.0, 'c16');
+INSERT INTO big_c VALUES (8.5, 'c17');
+INSERT INTO big_c VALUES (9.0, 'c18');
+INSERT INTO big_c VALUES (9.5, 'c19');
+INSERT INTO big_c VALUES (10.0, 'c20');
+INSERT INTO big_c VALUES (10.5, 'c21');
+INSERT INTO big_c VALUES (11.0, 'c22');
+INSERT INTO big_c VALUES (11.5, 'c23');
+INSERT INTO big_c VALUES (12.0, 'c24');
+INSERT INTO big_c VALUES (12.5, 'c25');
+INSERT INTO big_c VALUES (13.0, 'c26');
+INSERT INTO big_c VALUES (13.5, 'c27');
+INSERT INTO big_c VALUES (14.0, 'c28');
+INSERT INTO big_c VALUES (14.5, 'c29');
+INSERT INTO big_c VALUES (15.0, 'c30');
+INSERT INTO big_c VALUES (15.5, 'c31');
+INSERT INTO big_c VALUES (16.0, 'c32');
+INSERT INTO big_c VALUES (16.5, 'c33');
+INSERT INTO big_c VALUES (17.0, 'c34');
+INSERT INTO big_c VALUES (17.5, 'c35');
+INSERT INTO big_c VALUES (18.0, 'c36');
+INSERT INTO big_c VALUES (18.5, 'c37');
+INSERT INTO big_c VALUES (19.0, 'c38');
+INSERT INTO big_c VALUES (19.5, 'c39');
+INSERT INTO big_c VALUES (20.0, 'c40');
+INSERT INTO big_c VALUES (20.5, 'c41');
+INSERT INTO big_c VALUES (21.0, 'c42');
+INSERT INTO big_c VALUES (21.5, 'c43');
+INSERT INTO big_c VALUES (22.0, 'c44');
+INSERT INTO big_c VALUES (22.5, 'c45');
+INSERT INTO big_c VALUES (23.0, 'c46');
+INSERT INTO big_c VALUES (23.5, 'c47');
+INSERT INTO big_c VALUES (24.0, 'c48');
+INSERT INTO big_c VALUES (24.5, 'c49');
+INSERT INTO big_c VALUES (25.0, 'c50');
+INSERT INTO big_c VALUES (25.5, 'c51');
+INSERT INTO big_c VALUES (26.0, 'c52');
+INSERT INTO big_c VALUES (26.5, 'c53');
+INSERT INTO big_c VALUES (27.0, 'c54');
+INSERT INTO big_c VALUES (27.5, 'c55');
+INSERT INTO big_c VALUES (28.0, 'c56');
+INSERT INTO big_c VALUES (28.5, 'c57');
+INSERT INTO big_c VALUES (29.0, 'c58');
+INSERT INTO big_c VALUES (29.5, 'c59');
+INSERT INTO big_c VALUES (30.0, 'c60');
+INSERT INTO big_c VALUES (30.5, 'c61');
+INSERT INTO big_c VALUES (31.0, 'c62');
+INSERT INTO big_c VALUES (31.5, 'c63');
+INSERT INTO big_c VALUES (32.0, 'c64');
+INSERT INTO big_c VALUES (32.5, 'c65');
+INSERT INTO big_c VALUES (33.0, 'c66');
+INSERT INTO big_c VALUES (33.5, 'c67');
+INSERT INTO big_c VALUES (34.0, 'c68');
+INSERT INTO big_c VALUES (34.5, 'c69');
+INSERT INTO big_c VALUES (35.0, 'c70');
+INSERT INTO big_c VALUES (35.5, 'c71');
+INSERT INTO big_c VALUES (36.0, 'c72');
+INSERT INTO big_c VALUES (36.5, 'c73');
+INSERT INTO big_c VALUES (37.0, 'c74');
+INSERT INTO big_c VALUES (37.5, 'c75');
+INSERT INTO big_c VALUES (38.0, 'c76');
+INSERT INTO big_c VALUES (38.5, 'c77');
+INSERT INTO big_c VALUES (39.0, 'c78');
+INSERT INTO big_c VALUES (39.5, 'c79');
+INSERT INTO big_c VALUES (40.0, 'c80');
+INSERT INTO big_c VALUES (40.5, 'c81');
+INSERT INTO big_c VALUES (41.0, 'c82');
+INSERT INTO big_c VALUES (41.5, 'c83');
+INSERT INTO big_c VALUES (42.0, 'c84');
+INSERT INTO big_c VALUES (42.5, 'c85');
+INSERT INTO big_c VALUES (43.0, 'c86');
+INSERT INTO big_c VALUES (43.5, 'c87');
+INSERT INTO big_c VALUES (44.0, 'c88');
+INSERT INTO big_c VALUES (44.5, 'c89');
+INSERT INTO big_c VALUES (45.0, 'c90');
+INSERT INTO big_c VALUES (45.5, 'c91');
+INSERT INTO big_c VALUES (46.0, 'c92');
+INSERT INTO big_c VALUES (46.5, 'c93');
+INSERT INTO big_c VALUES (47.0, 'c94');
+INSERT INTO big_c VALUES (47.5, 'c95');
+INSERT INTO big_c VALUES (48.0, 'c96');
+INSERT INTO big_c VALUES (48.5, 'c97');
+INSERT INTO big_c VALUES (49.0, 'c98');
+INSERT INTO big_c VALUES (49.5, 'c99');
+INSERT INTO big_c VALUES (50.0, 'c100');
+SELECT a.name, b.tag FROM a INNER JOIN b ON a.id = b.k;
+SELECT b.tag, c.note FROM b INNER JOIN c ON b.k = c.v;
+SELECT c.note, a.name FROM c INNER JOIN a ON c.v = a.id;
+SELECT a.name, b.tag, c.note FROM a INNER JOIN b ON a.id = b.k INNER JOIN c ON b.k = c.v;
+SELECT big_a.name, big_b.tag FROM big_a INNER JOIN big_b ON big_a.id = big_b.k;
+SELECT big_a.name, big_c.note FROM big_a INNER JOIN big_c ON big_a.id = big_c.v;
+SELECT big_b.tag, big_c.note FROM big_b INNER JOIN big_c ON big_b.k = big_c.v;
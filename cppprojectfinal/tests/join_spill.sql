@@ -0,0 +1,563 @@
+CREATE DATABASE join_spill;
+USE DATABASE join_spill;
+CREATE TABLE orders (
+id INTEGER,
+customer INTEGER,
+amount FLOAT
+);
+CREATE TABLE customers (
+id INTEGER,
+name TEXT
+);
+INSERT INTO orders VALUES (1, 8, 1.5);
+INSERT INTO orders VALUES (2, 15, 2.5);
+INSERT INTO orders VALUES (3, 22, 3.5);
+INSERT INTO orders VALUES (4, 29, 4.5);
+INSERT INTO orders VALUES (5, 36, 5.5);
+INSERT INTO orders VALUES (6, 43, 6.5);
+INSERT INTO orders VALUES (7, 50, 7.5);
+INSERT INTO orders VALUES (8, 57, 8.5);
+INSERT INTO orders VALUES (9, 64, 9.5);
+INSERT INTO orders VALUES (10, 71, 10.5);
+INSERT INTO orders VALUES (11, 78, 11.5);
+INSERT INTO orders VALUES (12, 85, 12.5);
+INSERT INTO orders VALUES (13, 92, 13.5);
+INSERT INTO orders VALUES (14, 99, 14.5);
+INSERT INTO orders VALUES (15, 106, 15.5);
+INSERT INTO orders VALUES (16, 113, 16.5);
+INSERT INTO orders VALUES (17, 120, 17.5);
+INSERT INTO orders VALUES (18, 127, 18.5);
+INSERT INTO orders VALUES (19, 134, 19.5);
+INSERT INTO orders VALUES (20, 141, 20.5);
+INSERT INTO orders VALUES (21, 148, 21.5);
+INSERT INTO orders VALUES (22, 5, 22.5);
+INSERT INTO orders VALUES (23, 12, 23.5);
+INSERT INTO orders VALUES (24, 19, 24.5);
+INSERT INTO orders VALUES (25, 26, 25.5);
+INSERT INTO orders VALUES (26, 33, 26.5);
+INSERT INTO orders VALUES (27, 40, 27.5);
+INSERT INTO orders VALUES (28, 47, 28.5);
+INSERT INTO orders VALUES (29, 54, 29.5);
+INSERT INTO orders VALUES (30, 61, 30.5);
+INSERT INTO orders VALUES (31, 68, 31.5);
+INSERT INTO orders VALUES (32, 75, 32.5);
+INSERT INTO orders VALUES (33, 82, 33.5);
+INSERT INTO orders VALUES (34, 89, 34.5);
+INSERT INTO orders VALUES (35, 96, 35.5);
+INSERT INTO orders VALUES (36, 103, 36.5);
+INSERT INTO orders VALUES (37, 110, 37.5);
+INSERT INTO orders VALUES (38, 117, 38.5);
+INSERT INTO orders VALUES (39, 124, 39.5);
+INSERT INTO orders VALUES (40, 131, 40.5);
+INSERT INTO orders VALUES (41, 138, 41.5);
+INSERT INTO orders VALUES (42, 145, 42.5);
+INSERT INTO orders VALUES (43, 2, 43.5);
+INSERT INTO orders VALUES (44, 9, 44.5);
+INSERT INTO orders VALUES (45, 16, 45.5);
+INSERT INTO orders VALUES (46, 23, 46.5);
+INSERT INTO orders VALUES (47, 30, 47.5);
+INSERT INTO orders VALUES (48, 37, 48.5);
+INSERT INTO orders VALUES (49, 44, 49.5);
+INSERT INTO orders VALUES (50, 51, 0.5);
+INSERT INTO orders VALUES (51, 58, 1.5);
+INSERT INTO orders VALUES (52, 65, 2.5);
+INSERT INTO orders VALUES (53, 72, 3.5);
+INSERT INTO orders VALUES (54, 79, 4.5);
+INSERT INTO orders VALUES (55, 86, 5.5);
+INSERT INTO orders VALUES (56, 93, 6.5);
+INSERT INTO orders VALUES (57, 100, 7.5);
+INSERT INTO orders VALUES (58, 107, 8.5);
+INSERT INTO orders VALUES (59, 114, 9.5);
+INSERT INTO orders VALUES (60, 121, 10.5);
+INSERT INTO orders VALUES (61, 128, 11.5);
+INSERT INTO orders VALUES (62, 135, 12.5);
+INSERT INTO orders VALUES (63, 142, 13.5);
+INSERT INTO orders VALUES (64, 149, 14.5);
+INSERT INTO orders VALUES (65, 6, 15.5);
+INSERT INTO orders VALUES (66, 13, 16.5);
+INSERT INTO orders VALUES (67, 20, 17.5);
+INSERT INTO orders VALUES (68, 27, 18.5);
+INSERT INTO orders VALUES (69, 34, 19.5);
+INSERT INTO orders VALUES (70, 41, 20.5);
+INSERT INTO orders VALUES (71, 48, 21.5);
+INSERT INTO orders VALUES (72, 55, 22.5);
+INSERT INTO orders VALUES (73, 62, 23.5);
+INSERT INTO orders VALUES (74, 69, 24.5);
+INSERT INTO orders VALUES (75, 76, 25.5);
+INSERT INTO orders VALUES (76, 83, 26.5);
+INSERT INTO orders VALUES (77, 90, 27.5);
+INSERT INTO orders VALUES (78, 97, 28.5);
+INSERT INTO orders VALUES (79, 104, 29.5);
+INSERT INTO orders VALUES (80, 111, 30.5);
+INSERT INTO orders VALUES (81, 118, 31.5);
+INSERT INTO orders VALUES (82, 125, 32.5);
+INSERT INTO orders VALUES (83, 132, 33.5);
+INSERT INTO orders VALUES (84, 139, 34.5);
+INSERT INTO orders VALUES (85, 146, 35.5);
+INSERT INTO orders VALUES (86, 3, 36.5);
+INSERT INTO orders VALUES (87, 10, 37.5);
+INSERT INTO orders VALUES (88, 17, 38.5);
+INSERT INTO orders VALUES (89, 24, 39.5);
+INSERT INTO orders VALUES (90, 31, 40.5);
+INSERT INTO orders VALUES (91, 38, 41.5);
+INSERT INTO orders VALUES (92, 45, 42.5);
+INSERT INTO orders VALUES (93, 52, 43.5);
+INSERT INTO orders VALUES (94, 59, 44.5);
+INSERT INTO orders VALUES (95, 66, 45.5);
+INSERT INTO orders VALUES (96, 73, 46.5);
+INSERT INTO orders VALUES (97, 80, 47.5);
+INSERT INTO orders VALUES (98, 87, 48.5);
+INSERT INTO orders VALUES (99, 94, 49.5);
+INSERT INTO orders VALUES (100, 101, 0.5);
+INSERT INTO orders VALUES (101, 108, 1.5);
+INSERT INTO orders VALUES (102, 115, 2.5);
+INSERT INTO orders VALUES (103, 122, 3.5);
+INSERT INTO orders VALUES (104, 129, 4.5);
+INSERT INTO orders VALUES (105, 136, 5.5);
+INSERT INTO orders VALUES (106, 143, 6.5);
+INSERT INTO orders VALUES (107, 150, 7.5);
+INSERT INTO orders VALUES (108, 7, 8.5);
+INSERT INTO orders VALUES (109, 14, 9.5);
+INSERT INTO orders VALUES (110, 21, 10.5);
+INSERT INTO orders VALUES (111, 28, 11.5);
+INSERT INTO orders VALUES (112, 35, 12.5);
+INSERT INTO orders VALUES (113, 42, 13.5);
+INSERT INTO orders VALUES (114, 49, 14.5);
+INSERT INTO orders VALUES (115, 56, 15.5);
+INSERT INTO orders VALUES (116, 63, 16.5);
+INSERT INTO orders VALUES (117, 70, 17.5);
+INSERT INTO orders VALUES (118, 77, 18.5);
+INSERT INTO orders VALUES (119, 84, 19.5);
+INSERT INTO orders VALUES (120, 91, 20.5);
+INSERT INTO orders VALUES (121, 98, 21.5);
+INSERT INTO orders VALUES (122, 105, 22.5);
+INSERT INTO orders VALUES (123, 112, 23.5);
+INSERT INTO orders VALUES (124, 119, 24.5);
+INSERT INTO orders VALUES (125, 126, 25.5);
+INSERT INTO orders VALUES (126, 133, 26.5);
+INSERT INTO orders VALUES (127, 140, 27.5);
+INSERT INTO orders VALUES (128, 147, 28.5);
+INSERT INTO orders VALUES (129, 4, 29.5);
+INSERT INTO orders VALUES (130, 11, 30.5);
+INSERT INTO orders VALUES (131, 18, 31.5);
+INSERT INTO orders VALUES (132, 25, 32.5);
+INSERT INTO orders VALUES (133, 32, 33.5);
+INSERT INTO orders VALUES (134, 39, 34.5);
+INSERT INTO orders VALUES (135, 46, 35.5);
+INSERT INTO orders VALUES (136, 53, 36.5);
+INSERT INTO orders VALUES (137, 60, 37.5);
+INSERT INTO orders VALUES (138, 67, 38.5);
+INSERT INTO orders VALUES (139, 74, 39.5);
+INSERT INTO orders VALUES (140, 81, 40.5);
+INSERT INTO orders VALUES (141, 88, 41.5);
+INSERT INTO orders VALUES (142, 95, 42.5);
+INSERT INTO orders VALUES (143, 102, 43.5);
+INSERT INTO orders VALUES (144, 109, 44.5);
+INSERT INTO orders VALUES (145, 116, 45.5);
+INSERT INTO orders VALUES (146, 123, 46.5);
+INSERT INTO orders VALUES (147, 130, 47.5);
+INSERT INTO orders VALUES (148, 137, 48.5);
+INSERT INTO orders VALUES (149, 144, 49.5);
+INSERT INTO orders VALUES (150, 1, 0.5);
+INSERT INTO orders VALUES (151, 8, 1.5);
+INSERT INTO orders VALUES (152, 15, 2.5);
+INSERT INTO orders VALUES (153, 22, 3.5);
+INSERT INTO orders VALUES (154, 29, 4.5);
+INSERT INTO orders VALUES (155, 36, 5.5);
+INSERT INTO orders VALUES (156, 43, 6.5);
+INSERT INTO orders VALUES (157, 50, 7.5);
+INSERT INTO orders VALUES (158, 57, 8.5);
+INSERT INTO orders VALUES (159, 64, 9.5);
+INSERT INTO orders VALUES (160, 71, 10.5);
+INSERT INTO orders VALUES (161, 78, 11.5);
+INSERT INTO orders VALUES (162, 85, 12.5);
+INSERT INTO orders VALUES (163, 92, 13.5);
+INSERT INTO orders VALUES (164, 99, 14.5);
+INSERT INTO orders VALUES (165, 106, 15.5);
+INSERT INTO orders VALUES (166, 113, 16.5);
+INSERT INTO orders VALUES (167, 120, 17.5);
+INSERT INTO orders VALUES (168, 127, 18.5);
+INSERT INTO orders VALUES (169, 134, 19.5);
+INSERT INTO orders VALUES (170, 141, 20.5);
+INSERT INTO orders VALUES (171, 148, 21.5);
+INSERT INTO orders VALUES (172, 5, 22.5);
+INSERT INTO orders VALUES (173, 12, 23.5);
+INSERT INTO orders VALUES (174, 19, 24.5);
+INSERT INTO orders VALUES (175, 26, 25.5);
+INSERT INTO orders VALUES (176, 33, 26.5);
+INSERT INTO orders VALUES (177, 40, 27.5);
+INSERT INTO orders VALUES (178, 47, 28.5);
+INSERT INTO orders VALUES (179, 54, 29.5);
+INSERT INTO orders VALUES (180, 61, 30.5);
+INSERT INTO orders VALUES (181, 68, 31.5);
+INSERT INTO orders VALUES (182, 75, 32.5);
+INSERT INTO orders VALUES (183, 82, 33.5);
+INSERT INTO orders VALUES (184, 89, 34.5);
+INSERT INTO orders VALUES (185, 96, 35.5);
+INSERT INTO orders VALUES (186, 103, 36.5);
+INSERT INTO orders VALUES (187, 110, 37.5);
+INSERT INTO orders VALUES (188, 117, 38.5);
+INSERT INTO orders VALUES (189, 124, 39.5);
+INSERT INTO orders VALUES (190, 131, 40.5);
+INSERT INTO orders VALUES (191, 138, 41.5);
+INSERT INTO orders VALUES (192, 145, 42.5);
+INSERT INTO orders VALUES (193, 2, 43.5);
+INSERT INTO orders VALUES (194, 9, 44.5);
+INSERT INTO orders VALUES (195, 16, 45.5);
+INSERT INTO orders VALUES (196, 23, 46.5);
+INSERT INTO orders VALUES (197, 30, 47.5);
+INSERT INTO orders VALUES (198, 37, 48.5);
+INSERT INTO orders VALUES (199, 44, 49.5);
+INSERT INTO orders VALUES (200, 51, 0.5);
+INSERT INTO orders VALUES (201, 58, 1.5);
+INSERT INTO orders VALUES (202, 65, 2.5);
+INSERT INTO orders VALUES (203, 72, 3.5);
+INSERT INTO orders VALUES (204, 79, 4.5);
+INSERT INTO orders VALUES (205, 86, 5.5);
+INSERT INTO orders VALUES (206, 93, 6.5);
+INSERT INTO orders VALUES (207, 100, 7.5);
+INSERT INTO orders VALUES (208, 107, 8.5);
+INSERT INTO orders VALUES (209, 114, 9.5);
+INSERT INTO orders VALUES (210, 121, 10.5);
+INSERT INTO orders VALUES (211, 128, 11.5);
+INSERT INTO orders VALUES (212, 135, 12.5);
+INSERT INTO orders VALUES (213, 142, 13.5);
+INSERT INTO orders VALUES (214, 149, 14.5);
+INSERT INTO orders VALUES (215, 6, 15.5);
+INSERT INTO orders VALUES (216, 13, 16.5);
+INSERT INTO orders VALUES (217, 20, 17.5);
+INSERT INTO orders VALUES (218, 27, 18.5);
+INSERT INTO orders VALUES (219, 34, 19.5);
+INSERT INTO orders VALUES (220, 41, 20.5);
+INSERT INTO orders VALUES (221, 48, 21.5);
+INSERT INTO orders VALUES (222, 55, 22.5);
+INSERT INTO orders VALUES (223, 62, 23.5);
+INSERT INTO orders VALUES (224, 69, 24.5);
+INSERT INTO orders VALUES (225, 76, 25.5);
+INSERT INTO orders VALUES (226, 83, 26.5);
+INSERT INTO orders VALUES (227, 90, 27.5);
+INSERT INTO orders VALUES (228, 97, 28.5);
+INSERT INTO orders VALUES (229, 104, 29.5);
+INSERT INTO orders VALUES (230, 111, 30.5);
+INSERT INTO orders VALUES (231, 118, 31.5);
+INSERT INTO orders VALUES (232, 125, 32.5);
+INSERT INTO orders VALUES (233, 132, 33.5);
+INSERT INTO orders VALUES (234, 139, 34.5);
+INSERT INTO orders VALUES (235, 146, 35.5);
+INSERT INTO orders VALUES (236, 3, 36.5);
+INSERT INTO orders VALUES (237, 10, 37.5);
+INSERT INTO orders VALUES (238, 17, 38.5);
+INSERT INTO orders VALUES (239, 24, 39.5);
+INSERT INTO orders VALUES (240, 31, 40.5);
+INSERT INTO orders VALUES (241, 38, 41.5);
+INSERT INTO orders VALUES (242, 45, 42.5);
+INSERT INTO orders VALUES (243, 52, 43.5);
+INSERT INTO orders VALUES (244, 59, 44.5);
+INSERT INTO orders VALUES (245, 66, 45.5);
+INSERT INTO orders VALUES (246, 73, 46.5);
+INSERT INTO orders VALUES (247, 80, 47.5);
+INSERT INTO orders VALUES (248, 87, 48.5);
+INSERT INTO orders VALUES (249, 94, 49.5);
+INSERT INTO orders VALUES (250, 101, 0.5);
+INSERT INTO orders VALUES (251, 108, 1.5);
+INSERT INTO orders VALUES (252, 115, 2.5);
+INSERT INTO orders VALUES (253, 122, 3.5);
+INSERT INTO orders VALUES (254, 129, 4.5);
+INSERT INTO orders VALUES (255, 136, 5.5);
+INSERT INTO orders VALUES (256, 143, 6.5);
+INSERT INTO orders VALUES (257, 150, 7.5);
+INSERT INTO orders VALUES (258, 7, 8.5);
+INSERT INTO orders VALUES (259, 14, 9.5);
+INSERT INTO orders VALUES (260, 21, 10.5);
+INSERT INTO orders VALUES (261, 28, 11.5);
+INSERT INTO orders VALUES (262, 35, 12.5);
+INSERT INTO orders VALUES (263, 42, 13.5);
+INSERT INTO orders VALUES (264, 49, 14.5);
+INSERT INTO orders VALUES (265, 56, 15.5);
+INSERT INTO orders VALUES (266, 63, 16.5);
+INSERT INTO orders VALUES (267, 70, 17.5);
+INSERT INTO orders VALUES (268, 77, 18.5);
+INSERT INTO orders VALUES (269, 84, 19.5);
+INSERT INTO orders VALUES (270, 91, 20.5);
+INSERT INTO orders VALUES (271, 98, 21.5);
+INSERT INTO orders VALUES (272, 105, 22.5);
+INSERT INTO orders VALUES (273, 112, 23.5);
+INSERT INTO orders VALUES (274, 119, 24.5);
+INSERT INTO orders VALUES (275, 126, 25.5);
+INSERT INTO orders VALUES (276, 133, 26.5);
+INSERT INTO orders VALUES (277, 140, 27.5);
+INSERT INTO orders VALUES (278, 147, 28.5);
+INSERT INTO orders VALUES (279, 4, 29.5);
+INSERT INTO orders VALUES (280, 11, 30.5);
+INSERT INTO orders VALUES (281, 18, 31.5);
+INSERT INTO orders VALUES (282, 25, 32.5);
+INSERT INTO orders VALUES (283, 32, 33.5);
+INSERT INTO orders VALUES (284, 39, 34.5);
+INSERT INTO orders VALUES (285, 46, 35.5);
+INSERT INTO orders VALUES (286, 53, 36.5);
+INSERT INTO orders VALUES (287, 60, 37.5);
+INSERT INTO orders VALUES (288, 67, 38.5);
+INSERT INTO orders VALUES (289, 74, 39.5);
+INSERT INTO orders VALUES (290, 81, 40.5);
+INSERT INTO orders VALUES (291, 88, 41.5);
+INSERT INTO orders VALUES (292, 95, 42.5);
+INSERT INTO orders VALUES (293, 102, 43.5);
+INSERT INTO orders VALUES (294, 109, 44.5);
+INSERT INTO orders VALUES (295, 116, 45.5);
+INSERT INTO orders VALUES (296, 123, 46.5);
+INSERT INTO orders VALUES (297, 130, 47.5);
+INSERT INTO orders VALUES (298, 137, 48.5);
+INSERT INTO orders VALUES (299, 144, 49.5);
+INSERT INTO orders VALUES (300, 1, 0.5);
+INSERT INTO orders VALUES (301, 8, 1.5);
+INSERT INTO orders VALUES (302, 15, 2.5);
+INSERT INTO orders VALUES (303, 22, 3.5);
+INSERT INTO orders VALUES (304, 29, 4.5);
+INSERT INTO orders VALUES (305, 36, 5.5);
+INSERT INTO orders VALUES (306, 43, 6.5);
+INSERT INTO orders VALUES (307, 50, 7.5);
+INSERT INTO orders VALUES (308, 57, 8.5);
+INSERT INTO orders VALUES (309, 64, 9.5);
+INSERT INTO orders VALUES (310, 71, 10.5);
+INSERT INTO orders VALUES (311, 78, 11.5);
+INSERT INTO orders VALUES (312, 85, 12.5);
+INSERT INTO orders VALUES (313, 92, 13.5);
+INSERT INTO orders VALUES (314, 99, 14.5);
+INSERT INTO orders VALUES (315, 106, 15.5);
+INSERT INTO orders VALUES (316, 113, 16.5);
+INSERT INTO orders VALUES (317, 120, 17.5);
+INSERT INTO orders VALUES (318, 127, 18.5);
+INSERT INTO orders VALUES (319, 134, 19.5);
+INSERT INTO orders VALUES (320, 141, 20.5);
+INSERT INTO orders VALUES (321, 148, 21.5);
+INSERT INTO orders VALUES (322, 5, 22.5);
+INSERT INTO orders VALUES (323, 12, 23.5);
+INSERT INTO orders VALUES (324, 19, 24.5);
+INSERT INTO orders VALUES (325, 26, 25.5);
+INSERT INTO orders VALUES (326, 33, 26.5);
+INSERT INTO orders VALUES (327, 40, 27.5);
+INSERT INTO orders VALUES (328, 47, 28.5);
+INSERT INTO orders VALUES (329, 54, 29.5);
+INSERT INTO orders VALUES (330, 61, 30.5);
+INSERT INTO orders VALUES (331, 68, 31.5);
+INSERT INTO orders VALUES (332, 75, 32.5);
+INSERT INTO orders VALUES (333, 82, 33.5);
+INSERT INTO orders VALUES (334, 89, 34.5);
+INSERT INTO orders VALUES (335, 96, 35.5);
+INSERT INTO orders VALUES (336, 103, 36.5);
+INSERT INTO orders VALUES (337, 110, 37.5);
+INSERT INTO orders VALUES (338, 117, 38.5);
+INSERT INTO orders VALUES (339, 124, 39.5);
+INSERT INTO orders VALUES (340, 131, 40.5);
+INSERT INTO orders VALUES (341, 138, 41.5);
+INSERT INTO orders VALUES (342, 145, 42.5);
+INSERT INTO orders VALUES (343, 2, 43.5);
+INSERT INTO orders VALUES (344, 9, 44.5);
+INSERT INTO orders VALUES (345, 16, 45.5);
+INSERT INTO orders VALUES (346, 23, 46.5);
+INSERT INTO orders VALUES (347, 30, 47.5);
+INSERT INTO orders VALUES (348, 37, 48.5);
+INSERT INTO orders VALUES (349, 44, 49.5);
+INSERT INTO orders VALUES (350, 51, 0.5);
+INSERT INTO orders VALUES (351, 58, 1.5);
+INSERT INTO orders VALUES (352, 65, 2.5);
+INSERT INTO orders VALUES (353, 72, 3.5);
+INSERT INTO orders VALUES (354, 79, 4.5);
+INSERT INTO orders VALUES (355, 86, 5.5);
+INSERT INTO orders VALUES (356, 93, 6.5);
+INSERT INTO orders VALUES (357, 100, 7.5);
+INSERT INTO orders VALUES (358, 107, 8.5);
+INSERT INTO orders VALUES (359, 114, 9.5);
+INSERT INTO orders VALUES (360, 121, 10.5);
+INSERT INTO orders VALUES (361, 128, 11.5);
+INSERT INTO orders VALUES (362, 135, 12.5);
+INSERT INTO orders VALUES (363, 142, 13.5);
+INSERT INTO orders VALUES (364, 149, 14.5);
+INSERT INTO orders VALUES (365, 6, 15.5);
+INSERT INTO orders VALUES (366, 13, 16.5);
+INSERT INTO orders VALUES (367, 20, 17.5);
+INSERT INTO orders VALUES (368, 27, 18.5);
+INSERT INTO orders VALUES (369, 34, 19.5);
+INSERT INTO orders VALUES (370, 41, 20.5);
+INSERT INTO orders VALUES (371, 48, 21.5);
+INSERT INTO orders VALUES (372, 55, 22.5);
+INSERT INTO orders VALUES (373, 62, 23.5);
+INSERT INTO orders VALUES (374, 69, 24.5);
+INSERT INTO orders VALUES (375, 76, 25.5);
+INSERT INTO orders VALUES (376, 83, 26.5);
+INSERT INTO orders VALUES (377, 90, 27.5);
+INSERT INTO orders VALUES (378, 97, 28.5);
+INSERT INTO orders VALUES (379, 104, 29.5);
+INSERT INTO orders VALUES (380, 111, 30.5);
+INSERT INTO orders VALUES (381, 118, 31.5);
+INSERT INTO orders VALUES (382, 125, 32.5);
+INSERT INTO orders VALUES (383, 132, 33.5);
+INSERT INTO orders VALUES (384, 139, 34.5);
+INSERT INTO orders VALUES (385, 146, 35.5);
+INSERT INTO orders VALUES (386, 3, 36.5);
+INSERT INTO orders VALUES (387, 10, 37.5);
+INSERT INTO orders VALUES (388, 17, 38.5);
+INSERT INTO orders VALUES (389, 24, 39.5);
+INSERT INTO orders VALUES (390, 31, 40.5);
+INSERT INTO orders VALUES (391, 38, 41.5);
+INSERT INTO orders VALUES (392, 45, 42.5);
+INSERT INTO orders VALUES (393, 52, 43.5);
+INSERT INTO orders VALUES (394, 59, 44.5);
+INSERT INTO orders VALUES (395, 66, 45.5);
+INSERT INTO orders VALUES (396, 73, 46.5);
+INSERT INTO orders VALUES (397, 80, 47.5);
+INSERT INTO orders VALUES (398, 87, 48.5);
+INSERT INTO orders VALUES (399, 94, 49.5);
+INSERT INTO orders VALUES (400, 101, 0.5);
+INSERT INTO customers VALUES (1, 'customer_001');
+INSERT INTO customers VALUES (2, 'customer_002');
+INSERT INTO customers VALUES (3, 'customer_003');
+INSERT INTO customers VALUES (4, 'customer_004');
+INSERT INTO customers VALUES (5, 'customer_005');
+INSERT INTO customers VALUES (6, 'customer_006');
+INSERT INTO customers VALUES (7, 'customer_007');
+INSERT INTO customers VALUES (8, 'customer_008');
+INSERT INTO customers VALUES (9, 'customer_009');
+INSERT INTO customers VALUES (10, 'customer_010');
+INSERT INTO customers VALUES (11, 'customer_011');
+INSERT INTO customers VALUES (12, 'customer_012');
+INSERT INTO customers VALUES (13, 'customer_013');
+INSERT INTO customers VALUES (14, 'customer_014');
+INSERT INTO customers VALUES (15, 'customer_015');
+INSERT INTO customers VALUES (16, 'customer_016');
+INSERT INTO customers VALUES (17, 'customer_017');
+INSERT INTO customers VALUES (18, 'customer_018');
+INSERT INTO customers VALUES (19, 'customer_019');
+INSERT INTO customers VALUES (20, 'customer_020');
+INSERT INTO customers VALUES (21, 'customer_021');
+INSERT INTO customers VALUES (22, 'customer_022');
+INSERT INTO customers VALUES (23, 'customer_023');
+INSERT INTO customers VALUES (24, 'customer_024');
+INSERT INTO customers VALUES (25, 'customer_025');
+INSERT INTO customers VALUES (26, 'customer_026');
+INSERT INTO customers VALUES (27, 'customer_027');
+INSERT INTO customers VALUES (28, 'customer_028');
+INSERT INTO customers VALUES (29, 'customer_029');
+INSERT INTO customers VALUES (30, 'customer_030');
+INSERT INTO customers VALUES (31, 'customer_031');
+INSERT INTO customers VALUES (32, 'customer_032');
+INSERT INTO customers VALUES (33, 'customer_033');
+INSERT INTO customers VALUES (34, 'customer_034');
+INSERT INTO customers VALUES (35, 'customer_035');
+INSERT INTO customers VALUES (36, 'customer_036');
+INSERT INTO customers VALUES (37, 'customer_037');
+INSERT INTO customers VALUES (38, 'customer_038');
+INSERT INTO customers VALUES (39, 'customer_039');
+INSERT INTO customers VALUES (40, 'customer_040');
+INSERT INTO customers VALUES (41, 'customer_041');
+INSERT INTO customers VALUES (42, 'customer_042');
+INSERT INTO customers VALUES (43, 'customer_043');
+INSERT INTO customers VALUES (44, 'customer_044');
+INSERT INTO customers VALUES (45, 'customer_045');
+INSERT INTO customers VALUES (46, 'customer_046');
+INSERT INTO customers VALUES (47, 'customer_047');
+INSERT INTO customers VALUES (48, 'customer_048');
+INSERT INTO customers VALUES (49, 'customer_049');
+INSERT INTO customers VALUES (50, 'customer_050');
+INSERT INTO customers VALUES (51, 'customer_051');
+INSERT INTO customers VALUES (52, 'customer_052');
+INSERT INTO customers VALUES (53, 'customer_053');
+INSERT INTO customers VALUES (54, 'customer_054');
+INSERT INTO customers VALUES (55, 'customer_055');
+INSERT INTO customers VALUES (56, 'customer_056');
+INSERT INTO customers VALUES (57, 'customer_057');
+INSERT INTO customers VALUES (58, 'customer_058');
+INSERT INTO customers VALUES (59, 'customer_059');
+INSERT INTO customers VALUES (60, 'customer_060');
+INSERT INTO customers VALUES (61, 'customer_061');
+INSERT INTO customers VALUES (62, 'customer_062');
+INSERT INTO customers VALUES (63, 'customer_063');
+INSERT INTO customers VALUES (64, 'customer_064');
+INSERT INTO customers VALUES (65, 'customer_065');
+INSERT INTO customers VALUES (66, 'customer_066');
+INSERT INTO customers VALUES (67, 'customer_067');
+INSERT INTO customers VALUES (68, 'customer_068');
+INSERT INTO customers VALUES (69, 'customer_069');
+INSERT INTO customers VALUES (70, 'customer_070');
+INSERT INTO customers VALUES (71, 'customer_071');
+INSERT INTO customers VALUES (72, 'customer_072');
+INSERT INTO customers VALUES (73, 'customer_073');
+INSERT INTO customers VALUES (74, 'customer_074');
+INSERT INTO customers VALUES (75, 'customer_075');
+INSERT INTO customers VALUES (76, 'customer_076');
+INSERT INTO customers VALUES (77, 'customer_077');
+INSERT INTO customers VALUES (78, 'customer_078');
+INSERT INTO customers VALUES (79, 'customer_079');
+INSERT INTO customers VALUES (80, 'customer_080');
+INSERT INTO customers VALUES (81, 'customer_081');
+INSERT INTO customers VALUES (82, 'customer_082');
+INSERT INTO customers VALUES (83, 'customer_083');
+INSERT INTO customers VALUES (84, 'customer_084');
+INSERT INTO customers VALUES (85, 'customer_085');
+INSERT INTO customers VALUES (86, 'customer_086');
+INSERT INTO customers VALUES (87, 'customer_087');
+INSERT INTO customers VALUES (88, 'customer_088');
+INSERT INTO customers VALUES (89, 'customer_089');
+INSERT INTO customers VALUES (90, 'customer_090');
+INSERT INTO customers VALUES (91, 'customer_091');
+INSERT INTO customers VALUES (92, 'customer_092');
+INSERT INTO customers VALUES (93, 'customer_093');
+INSERT INTO customers VALUES (94, 'customer_094');
+INSERT INTO customers VALUES (95, 'customer_095');
+INSERT INTO customers VALUES (96, 'customer_096');
+INSERT INTO customers VALUES (97, 'customer_097');
+INSERT INTO customers VALUES (98, 'customer_098');
+INSERT INTO customers VALUES (99, 'customer_099');
+INSERT INTO customers VALUES (100, 'customer_100');
+INSERT INTO customers VALUES (101, 'customer_101');
+INSERT INTO customers VALUES (102, 'customer_102');
+INSERT INTO customers VALUES (103, 'customer_103');
+INSERT INTO customers VALUES (104, 'customer_104');
+INSERT INTO customers VALUES (105, 'customer_105');
+INSERT INTO customers VALUES (106, 'customer_106');
+INSERT INTO customers VALUES (107, 'customer_107');
+INSERT INTO customers VALUES (108, 'customer_108');
+INSERT INTO customers VALUES (109, 'customer_109');
+INSERT INTO customers VALUES (110, 'customer_110');
+INSERT INTO customers VALUES (111, 'customer_111');
+INSERT INTO customers VALUES (112, 'customer_112');
+INSERT INTO customers VALUES (113, 'customer_113');
+INSERT INTO customers VALUES (114, 'customer_114');
+INSERT INTO customers VALUES (115, 'customer_115');
+INSERT INTO customers VALUES (116, 'customer_116');
+INSERT INTO customers VALUES (117, 'customer_117');
+INSERT INTO customers VALUES (118, 'customer_118');
+INSERT INTO customers VALUES (119, 'customer_119');
+INSERT INTO customers VALUES (120, 'customer_120');
+INSERT INTO customers VALUES (121, 'customer_121');
+INSERT INTO customers VALUES (122, 'customer_122');
+INSERT INTO customers VALUES (123, 'customer_123');
+INSERT INTO customers VALUES (124, 'customer_124');
+INSERT INTO customers VALUES (125, 'customer_125');
+INSERT INTO customers VALUES (126, 'customer_126');
+INSERT INTO customers VALUES (127, 'customer_127');
+INSERT INTO customers VALUES (128, 'customer_128');
+INSERT INTO customers VALUES (129, 'customer_129');
+INSERT INTO customers VALUES (130, 'customer_130');
+INSERT INTO customers VALUES (131, 'customer_131');
+INSERT INTO customers VALUES (132, 'customer_132');
+INSERT INTO customers VALUES (133, 'customer_133');
+INSERT INTO customers VALUES (134, 'customer_134');
+INSERT INTO customers VALUES (135, 'customer_135');
+INSERT INTO customers VALUES (136, 'customer_136');
+INSERT INTO customers VALUES (137, 'customer_137');
+INSERT INTO customers VALUES (138, 'customer_138');
+INSERT INTO customers VALUES (139, 'customer_139');
+INSERT INTO customers VALUES (140, 'customer_140');
+INSERT INTO customers VALUES (141, 'customer_141');
+INSERT INTO customers VALUES (142, 'customer_142');
+INSERT INTO customers VALUES (143, 'customer_143');
+INSERT INTO customers VALUES (144, 'customer_144');
+INSERT INTO customers VALUES (145, 'customer_145');
+INSERT INTO customers VALUES (146, 'customer_146');
+INSERT INTO customers VALUES (147, 'customer_147');
+INSERT INTO customers VALUES (148, 'customer_148');
+INSERT INTO customers VALUES (149, 'customer_149');
+INSERT INTO customers VALUES (150, 'customer_150');
+SELECT orders.id, customers.name, orders.amount FROM orders INNER JOIN customers ON orders.customer = customers.id;
+SELECT customers.name, orders.id FROM customers INNER JOIN orders ON customers.id = orders.customer WHERE orders.amount > 40;
@@ -0,0 +1,26 @@
+CREATE DATABASE partitions;
+USE DATABASE partitions;
+CREATE TABLE events (
+name TEXT,
+score FLOAT
+) PARTITION BY HASH(name) PARTITIONS 4;
+CREATE TABLE grades (
+id INTEGER,
+gpa FLOAT
+) PARTITION BY RANGE(gpa) (2.0, 3.0, 3.5);
+INSERT INTO events VALUES ('a', 0.5);
+INSERT INTO events VALUES ('b', 1.5);
+INSERT INTO events VALUES ('c', 2.5);
+INSERT INTO events VALUES ('d', 3.5);
+INSERT INTO events VALUES ('e', 4.5);
+INSERT INTO grades VALUES (1, 3.9);
+INSERT INTO grades VALUES (2, 2.9);
+INSERT INTO grades VALUES (3, 1.5);
+INSERT INTO grades VALUES (4, 3.5);
+INSERT INTO grades VALUES (5, 2.0);
+INSERT INTO grades VALUES (6, 3.2);
+SELECT name, score FROM events;
+SELECT name, score FROM events WHERE name = 'd';
+EXPLAIN SELECT score FROM events WHERE name = 'd';
+SELECT id, gpa FROM grades;
+SELECT id, gpa FROM grades WHERE gpa > 3.0;
@@ -0,0 +1,11 @@
+CREATE DATABASE shared_error;
+USE DATABASE shared_error;
+CREATE TABLE t (
+id INTEGER
+);
+INSERT INTO t VALUES (1);
+INSERT INTO t VALUES (2);
+INSERT INTO t VALUES (3);
+SELECT id FROM t WHERE id = 'x';
+SELECT id FROM t;
+SELECT id FROM t WHERE id > 1;
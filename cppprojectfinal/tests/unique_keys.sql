@@ -0,0 +1,18 @@
+CREATE DATABASE unique_keys;
+USE DATABASE unique_keys;
+CREATE TABLE accounts (
+id INTEGER PRIMARY KEY,
+email TEXT UNIQUE,
+balance FLOAT
+);
+INSERT INTO accounts VALUES (1, 'a@x', 10.5);
+INSERT INTO accounts VALUES (2, 'b@x', 20.0);
+INSERT INTO accounts VALUES (01, 'c@x', 30.0);
+INSERT INTO accounts VALUES (3, 'a@x', 40.0);
+INSERT INTO accounts VALUES (3, 'c@x', 40.0);
+SELECT id, email, balance FROM accounts;
+UPDATE accounts SET id = 2 WHERE id = 3;
+UPDATE accounts SET email = 'b@x' WHERE id = 1;
+UPDATE accounts SET email = 'd@x' WHERE id = 1;
+SELECT id, email, balance FROM accounts;
+SELECT email FROM accounts WHERE id = 3;